@@ -0,0 +1,488 @@
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "AdjacencyListAlgorithm.h"
+#include "Tools.h"
+#include "MemoryManager.h"
+
+// system includes
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <vector>
+
+using namespace std;
+
+/*! \file AdjacencyListAlgorithm.cpp
+
+    \brief This file contains the algorithm for listing all maximal cliques
+           according to the algorithm of Tomita et al. (TCS 2006), using
+           adjacency lists instead of an adjacency matrix.
+
+    \author Darren Strash (first name DOT last name AT gmail DOT com)
+
+    \copyright Copyright (c) 2011 Darren Strash. This code is released under the GNU Public License (GPL) 3.0.
+
+    \image html gplv3-127x51.png
+
+    \htmlonly
+    <center>
+    <a href="gpl-3.0-standalone.html">See GPL 3.0 here</a>
+    </center>
+    \endhtmlonly
+
+    The sets X, P, and R are stored in a single array, partitioned as
+    |--X--|--P--|--R--|, and vertexLookup gives the position of each
+    vertex in that array, so membership of a neighbor in X or P is
+    decided by its position. Every operation scans adjacency lists
+    instead of rows of a matrix, so this algorithm uses space linear
+    in the size of the graph, but it still starts the search with all
+    vertices in P.
+*/
+
+AdjacencyListAlgorithm::AdjacencyListAlgorithm(vector<list<int>> &&adjacencyList)
+ : Algorithm("adjlist")
+ , m_iNumVertices(adjacencyList.size())
+ , m_AdjacencyList(nullptr)
+ , m_Degree(nullptr)
+{
+    m_AdjacencyList = (int**)Calloc(m_iNumVertices, sizeof(int*));
+    m_Degree = (int*)Calloc(m_iNumVertices, sizeof(int));
+
+    for (int i = 0; i < m_iNumVertices; i++) {
+        m_Degree[i] = adjacencyList[i].size();
+        m_AdjacencyList[i] = (int*)Calloc(m_Degree[i], sizeof(int));
+
+        int j = 0;
+        for (int const neighbor : adjacencyList[i]) {
+            m_AdjacencyList[i][j++] = neighbor;
+        }
+
+        // release each list as soon as it is copied into an array
+        list<int>().swap(adjacencyList[i]);
+    }
+
+    vector<list<int>>().swap(adjacencyList);
+}
+
+AdjacencyListAlgorithm::~AdjacencyListAlgorithm()
+{
+    for (int i = 0; i < m_iNumVertices; i++) {
+        Free(m_AdjacencyList[i]);
+    }
+
+    Free(m_AdjacencyList);
+    Free(m_Degree);
+}
+
+long AdjacencyListAlgorithm::Run(list<list<int>> &cliques)
+{
+    return listAllMaximalCliquesAdjacencyList();
+}
+
+/*! \brief Computes the vertex v in P union X that has the most neighbors in P,
+           and places P \ {neighborhood of v} in an array. These are the 
+           vertices to consider adding to the partial clique during the current
+           recursive call of the algorithm.
+
+    \param pivotNonNeighbors  An intially unallocated pointer, which will contain the set 
+                              P \ {neighborhood of v} when this function completes.
+
+    \param numNonNeighbors A pointer to a single integer, which has been preallocated,
+                           which will contain the number of elements in pivotNonNeighbors.
+
+    \param adjacencyList An array of arrays, representing the input graph in a more
+                         compact and cache-friendly adjacency list format.
+
+    \param degree An array, indexed by vertex, containing the degree of that vertex.
+ 
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R, and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param beginX The index where set X begins in vertexSets.
+ 
+    \param beginP The index where set P begins in vertexSets.
+
+    \param beginR The index where set R begins in vertexSets.
+
+*/
+
+inline int findBestPivotNonNeighborsAdjacencyList( int** pivotNonNeighbors, int* numNonNeighbors,
+                                                   int** adjacencyList, int* degree,
+                                                   int* vertexSets, int* vertexLookup,
+                                                   int beginX, int beginP, int beginR)
+{
+    int pivot = vertexSets[beginP];
+    int maxIntersectionSize = -1;
+
+    // iterate over each vertex in P union X 
+    // to find the vertex with the most neighbors in P.
+    int j = beginX;
+    while(j<beginR)
+    {
+        int vertex = vertexSets[j];
+
+        // no vertex has more neighbors in P than P has vertices
+        if(degree[vertex] > maxIntersectionSize)
+        {
+            int numNeighborsInP = 0;
+
+            int k = 0;
+            while(k<degree[vertex])
+            {
+                int neighborLocation = vertexLookup[adjacencyList[vertex][k]];
+                if(neighborLocation >= beginP && neighborLocation < beginR)
+                {
+                    numNeighborsInP++;
+                }
+
+                k++;
+            }
+
+            if(numNeighborsInP > maxIntersectionSize)
+            {
+                pivot = vertex;
+                maxIntersectionSize = numNeighborsInP;
+            }
+        }
+
+        j++;
+    }
+
+    // we initialize enough space for all of P; this is
+    // slightly space inefficient, but it results in faster
+    // computation of non-neighbors.
+    *pivotNonNeighbors = (int*)Calloc(beginR-beginP, sizeof(int));
+    memcpy(*pivotNonNeighbors, &vertexSets[beginP], (beginR-beginP)*sizeof(int));
+
+    // mark the neighbors of the pivot in P, which sit at the same
+    // offset in the copy as in vertexSets, then compact the rest.
+    j = 0;
+    while(j<degree[pivot])
+    {
+        int neighborLocation = vertexLookup[adjacencyList[pivot][j]];
+        if(neighborLocation >= beginP && neighborLocation < beginR)
+        {
+            (*pivotNonNeighbors)[neighborLocation-beginP] = -1;
+        }
+
+        j++;
+    }
+
+    *numNonNeighbors = 0;
+    j = 0;
+    while(j<beginR-beginP)
+    {
+        if((*pivotNonNeighbors)[j] != -1)
+        {
+            (*pivotNonNeighbors)[(*numNonNeighbors)++] = (*pivotNonNeighbors)[j];
+        }
+
+        j++;
+    }
+
+    return pivot; 
+}
+
+/*! \brief Move a vertex to the set R, and update the sets P and X
+
+    \param vertex The vertex to move to R.
+
+    \param adjacencyList An array of arrays, representing the input graph in a more
+                         compact and cache-friendly adjacency list format.
+
+    \param degree An array, indexed by vertex, containing the degree of that vertex.
+
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R, and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param pBeginX The index where set X begins in vertexSets.
+ 
+    \param pBeginP The index where set P begins in vertexSets.
+
+    \param pBeginR The index where set R begins in vertexSets.
+
+    \param pNewBeginX After function, contains the new index where set X begins
+                      in vertexSets after adding vertex to R.
+ 
+    \param pNewBeginP After function, contains the new index where set P begins
+                      in vertexSets after adding vertex to P.
+
+    \param pNewBeginR After function, contains the new index where set R begins
+                      in vertexSets after adding vertex to R.
+*/
+
+inline void moveToRAdjacencyList( int vertex, 
+                                  int** adjacencyList, int* degree,
+                                  int* vertexSets, int* vertexLookup, 
+                                  int* pBeginX, int *pBeginP, int *pBeginR, 
+                                  int* pNewBeginX, int* pNewBeginP, int *pNewBeginR)
+{
+    int vertexLocation = vertexLookup[vertex];
+
+    (*pBeginR)--;
+    vertexSets[vertexLocation] = vertexSets[*pBeginR];
+    vertexLookup[vertexSets[*pBeginR]] = vertexLocation;
+    vertexSets[*pBeginR] = vertex;
+    vertexLookup[vertex] = *pBeginR;
+
+    // this is not a typo, initially newX is empty
+    *pNewBeginX = *pBeginP;
+    *pNewBeginP = *pBeginP;
+    *pNewBeginR = *pBeginP;
+
+    // swap neighbors of vertex in X to the end of X,
+    // and neighbors of vertex in P to the beginning of P
+    int j = 0;
+    while(j<degree[vertex])
+    {
+        int neighbor = adjacencyList[vertex][j];
+        int neighborLocation = vertexLookup[neighbor];
+
+        if(neighborLocation >= *pBeginX && neighborLocation < *pNewBeginX)
+        {
+            (*pNewBeginX)--;
+            vertexSets[neighborLocation] = vertexSets[*pNewBeginX];
+            vertexLookup[vertexSets[*pNewBeginX]] = neighborLocation;
+            vertexSets[*pNewBeginX] = neighbor;
+            vertexLookup[neighbor] = *pNewBeginX;
+        }
+        else if(neighborLocation >= *pNewBeginR && neighborLocation < *pBeginR)
+        {
+            vertexSets[neighborLocation] = vertexSets[*pNewBeginR];
+            vertexLookup[vertexSets[*pNewBeginR]] = neighborLocation;
+            vertexSets[*pNewBeginR] = neighbor;
+            vertexLookup[neighbor] = *pNewBeginR;
+            (*pNewBeginR)++;
+        }
+
+        j++;
+    }
+}
+
+/*! \brief Move a vertex from the set R to the set X, and update all necessary pointers
+
+    \param vertex The vertex to move from R to X.
+
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R, and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param pBeginX The index where set X begins in vertexSets.
+ 
+    \param pBeginP The index where set P begins in vertexSets.
+
+    \param pBeginR The index where set R begins in vertexSets.
+
+*/
+
+inline void moveFromRToXAdjacencyList( int vertex, 
+                                       int* vertexSets, int* vertexLookup, 
+                                       int* pBeginX, int* pBeginP, int* pBeginR )
+{
+    int vertexLocation = vertexLookup[vertex];
+
+    //swap vertex into X and increment beginP and beginR
+    vertexSets[vertexLocation] = vertexSets[*pBeginP];
+    vertexLookup[vertexSets[*pBeginP]] = vertexLocation;
+    vertexSets[*pBeginP] = vertex;
+    vertexLookup[vertex] = *pBeginP;
+
+    *pBeginP = *pBeginP + 1;
+    *pBeginR = *pBeginR + 1;
+}
+
+/*! \brief List all maximal cliques in the graph using the algorithm
+           by Tomita et al. (TCS 2006), with adjacency lists.
+
+    \return the number of maximal cliques of the input graph.
+*/
+
+long AdjacencyListAlgorithm::listAllMaximalCliquesAdjacencyList()
+{
+    int const size(m_iNumVertices);
+
+    // vertex sets are stored in an array like this:
+    // |--X--|--P--|--R--|
+    int* vertexSets = (int*)Calloc(size, sizeof(int));
+
+    // vertex i is stored in vertexSets[vertexLookup[i]]
+    int* vertexLookup = (int*)Calloc(size, sizeof(int));
+
+    int i = 0;
+    while(i<size)
+    {
+        vertexLookup[i] = i;
+        vertexSets[i] = i;
+        i++;
+    }
+
+    long cliqueCount = 0;
+
+    list<int> partialClique;
+
+    // statistics are gathered locally, and published when the run completes
+    EnumerationStatistics statistics;
+    EnumerationStatistics* pStatistics = GetCollectStatistics() ? &statistics : nullptr;
+    ClearStatistics();
+    if (pStatistics) pStatistics->Start();
+
+    // initially, all vertices are in P
+    if (size > 0) {
+        listAllMaximalCliquesAdjacencyListRecursive(&cliqueCount,
+                                                    partialClique,
+                                                    vertexSets, vertexLookup,
+                                                    0, 0, size,
+                                                    pStatistics);
+    }
+
+    if (pStatistics) MergeStatistics(statistics);
+
+    Free(vertexSets);
+    Free(vertexLookup);
+
+    return cliqueCount;
+}
+
+/*! \brief Recursively list all maximal cliques containing all of
+           all vertices in R, some vertices in P and no vertices in X.
+
+    \param cliqueCount A pointer to the number of maximal cliques computed 
+                       thus far.
+
+    \param partialClique A linked list storing R, the partial clique for this
+                         recursive call. 
+
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param beginX The index where set X begins in vertexSets.
+ 
+    \param beginP The index where set P begins in vertexSets.
+
+    \param beginR The index where set R begins in vertexSets.
+
+    \param pStatistics If non-null, delay statistics for this run are recorded here.
+
+*/
+
+void AdjacencyListAlgorithm::listAllMaximalCliquesAdjacencyListRecursive(long* cliqueCount,
+                                                                        list<int> &partialClique,
+                                                                        int* vertexSets, int* vertexLookup,
+                                                                        int beginX, int beginP, int beginR,
+                                                                        EnumerationStatistics* pStatistics)
+{
+    if (pStatistics) pStatistics->RecordNode(partialClique.size());
+
+    // if X is empty and P is empty, process partial clique as maximal
+    if(beginX >= beginP && beginP >= beginR)
+    {
+        (*cliqueCount)++;
+
+        if (pStatistics) pStatistics->RecordClique(partialClique.size());
+
+        ExecuteCallBacks(partialClique);
+        processClique(partialClique);
+
+        return;
+    }
+
+    // avoid work if P is empty.
+    if(beginP >= beginR)
+        return;
+
+    int* myCandidatesToIterateThrough;
+    int numCandidatesToIterateThrough;
+
+    // get the candidates to add to R to make a maximal clique
+    findBestPivotNonNeighborsAdjacencyList( &myCandidatesToIterateThrough,
+                                            &numCandidatesToIterateThrough,
+                                            m_AdjacencyList, m_Degree,
+                                            vertexSets, vertexLookup,
+                                            beginX, beginP, beginR);
+
+    // add candiate vertices to the partial clique one at a time and 
+    // search for maximal cliques
+    int iterator = 0;
+    while(iterator < numCandidatesToIterateThrough)
+    {
+        // vertex to be added to the partial clique
+        int vertex = myCandidatesToIterateThrough[iterator];
+
+        #ifdef PRINT_CLIQUES_TOMITA_STYLE
+        printf("%d ", vertex);
+        #endif
+
+        int newBeginX, newBeginP, newBeginR;
+
+        // add vertex into partialClique, representing R.
+        partialClique.push_back(vertex);
+
+        // swap vertex into R and update all data structures 
+        moveToRAdjacencyList( vertex, 
+                              m_AdjacencyList, m_Degree,
+                              vertexSets, vertexLookup, 
+                              &beginX, &beginP, &beginR, 
+                              &newBeginX, &newBeginP, &newBeginR);
+
+        // recursively compute maximal cliques with new sets R, P and X
+        listAllMaximalCliquesAdjacencyListRecursive(cliqueCount,
+                                                    partialClique,
+                                                    vertexSets, vertexLookup,
+                                                    newBeginX, newBeginP, newBeginR,
+                                                    pStatistics);
+
+        #ifdef PRINT_CLIQUES_TOMITA_STYLE
+        printf("b ");
+        #endif
+
+        // remove vertex from partialClique
+        partialClique.pop_back();
+
+        moveFromRToXAdjacencyList( vertex, 
+                                   vertexSets, vertexLookup,
+                                   &beginX, &beginP, &beginR );
+
+        iterator++;
+    }
+
+    // swap vertices that were moved to X back into P, for higher recursive calls.
+    iterator = 0;
+    while(iterator < numCandidatesToIterateThrough)
+    {
+        int vertex = myCandidatesToIterateThrough[iterator];
+        int vertexLocation = vertexLookup[vertex];
+
+        beginP--;
+        vertexSets[vertexLocation] = vertexSets[beginP];
+        vertexSets[beginP] = vertex;
+        vertexLookup[vertex] = beginP;
+        vertexLookup[vertexSets[vertexLocation]] = vertexLocation;
+
+        iterator++;
+    }
+
+    Free(myCandidatesToIterateThrough);
+}
@@ -8,6 +8,8 @@ using namespace std;
 Algorithm::Algorithm(std::string const &name)
  : m_sName(name)
  , m_bQuiet(false)
+ , m_bCollectStatistics(false)
+ , m_Statistics()
  , m_vCallBacks()
 {
 }
@@ -46,4 +48,37 @@ void Algorithm::SetQuiet(bool const quiet)
 bool Algorithm::GetQuiet() const
 {
     return m_bQuiet;
-}
\ No newline at end of file
+}
+
+/*! \brief turn on (or off) the collection of delay statistics
+           (e.g., time between consecutive cliques) in the next runs.
+*/
+
+void Algorithm::SetCollectStatistics(bool const collect)
+{
+    m_bCollectStatistics = collect;
+}
+
+bool Algorithm::GetCollectStatistics() const
+{
+    return m_bCollectStatistics;
+}
+
+/*! \brief the statistics of the most recent run, merged over all
+           threads of that run. Empty unless statistics were collected.
+*/
+
+EnumerationStatistics const &Algorithm::GetStatistics() const
+{
+    return m_Statistics;
+}
+
+void Algorithm::ClearStatistics()
+{
+    m_Statistics.Clear();
+}
+
+void Algorithm::MergeStatistics(EnumerationStatistics const &statistics)
+{
+    m_Statistics.Merge(statistics);
+}
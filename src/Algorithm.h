@@ -1,6 +1,9 @@
 #ifndef ALGORITHM_H
 #define ALGORITHM_H
 
+// local includes
+#include "EnumerationStatistics.h"
+
 // system includes
 #include <vector>
 #include <list>
@@ -26,9 +29,19 @@ public:
     void SetQuiet(bool const quiet);
     bool GetQuiet() const;
 
+    void SetCollectStatistics(bool const collect);
+    bool GetCollectStatistics() const;
+    EnumerationStatistics const &GetStatistics() const;
+
+protected:
+    void ClearStatistics();
+    void MergeStatistics(EnumerationStatistics const &statistics);
+
 private:
     std::string m_sName;
     bool m_bQuiet;
+    bool m_bCollectStatistics;
+    EnumerationStatistics m_Statistics;
     std::vector<std::function<void(std::list<int> const&)>> m_vCallBacks;
 };
 
@@ -0,0 +1,296 @@
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "BitSetTomitaAlgorithm.h"
+#include "Tools.h"
+#include "MemoryManager.h"
+
+// system includes
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <vector>
+
+using namespace std;
+
+/*! \file BitSetTomitaAlgorithm.cpp
+
+    \brief This file contains the algorithm for listing all maximal cliques
+           according to the algorithm of Tomita et al. (TCS 2006), using
+           an adjacency matrix packed 64 vertices to a word.
+
+    The sets P and X are bitsets over all vertices, so P and X intersected
+    with the neighborhood of a vertex are computed a word at a time, and
+    the pivot is chosen by popcount. Each recursive call also tracks the
+    words in which P union X has set bits, and only scans those, so sparse
+    sets over many vertices stay cheap.
+    The sets for each depth of the recursion are allocated once, and reused
+    by every call at that depth.
+
+    The matrix takes n^2/8 bytes, an eighth of the matrix used by
+    TomitaAlgorithm, so this algorithm is suitable for small graphs and
+    for dense graphs with up to MAX_VERTICES vertices.
+*/
+
+namespace
+{
+    inline int PopCount(uint64_t const word)
+    {
+        return __builtin_popcountll(word);
+    }
+
+    inline int LowestBit(uint64_t const word)
+    {
+        return __builtin_ctzll(word);
+    }
+};
+
+BitSetTomitaAlgorithm::BitSetTomitaAlgorithm(vector<list<int>> &&adjacencyList)
+ : Algorithm("bitset")
+ , m_iNumVertices(adjacencyList.size())
+ , m_iNumWords((adjacencyList.size() + 63)/64)
+ , m_AdjacencyMatrix(nullptr)
+ , m_vScratch()
+ , m_vWordScratch()
+{
+    m_AdjacencyMatrix = (uint64_t*)Calloc(static_cast<size_t>(m_iNumVertices)*m_iNumWords, sizeof(uint64_t));
+
+    for (int i = 0; i < m_iNumVertices; i++) {
+        uint64_t* row = m_AdjacencyMatrix + static_cast<size_t>(i)*m_iNumWords;
+        for (int const neighbor : adjacencyList[i]) {
+            row[neighbor/64] |= (uint64_t(1) << (neighbor%64));
+        }
+
+        // the matrix is the only representation this algorithm reads
+        list<int>().swap(adjacencyList[i]);
+    }
+
+    vector<list<int>>().swap(adjacencyList);
+}
+
+BitSetTomitaAlgorithm::~BitSetTomitaAlgorithm()
+{
+    for (uint64_t* scratch : m_vScratch) {
+        Free(scratch);
+    }
+
+    for (int* wordScratch : m_vWordScratch) {
+        Free(wordScratch);
+    }
+
+    Free(m_AdjacencyMatrix);
+}
+
+long BitSetTomitaAlgorithm::Run(list<list<int>> &cliques)
+{
+    return listAllMaximalCliquesBitSet();
+}
+
+/*! \brief List all maximal cliques in the graph using the algorithm
+           by Tomita et al. (TCS 2006), with a packed adjacency matrix.
+
+    \return the number of maximal cliques of the input graph.
+*/
+
+long BitSetTomitaAlgorithm::listAllMaximalCliquesBitSet()
+{
+    // initially, all vertices are in P
+    uint64_t* P = (uint64_t*)Calloc(m_iNumWords, sizeof(uint64_t));
+    uint64_t* X = (uint64_t*)Calloc(m_iNumWords, sizeof(uint64_t));
+
+    for (int vertex = 0; vertex < m_iNumVertices; vertex++) {
+        P[vertex/64] |= (uint64_t(1) << (vertex%64));
+    }
+
+    long cliqueCount = 0;
+
+    list<int> partialClique;
+
+    // statistics are gathered locally, and published when the run completes
+    EnumerationStatistics statistics;
+    EnumerationStatistics* pStatistics = GetCollectStatistics() ? &statistics : nullptr;
+    ClearStatistics();
+    if (pStatistics) pStatistics->Start();
+
+    int* words = (int*)Calloc(m_iNumWords, sizeof(int));
+    for (int word = 0; word < m_iNumWords; word++) {
+        words[word] = word;
+    }
+
+    if (m_iNumVertices > 0) {
+        listAllMaximalCliquesBitSetRecursive(&cliqueCount,
+                                             partialClique,
+                                             P, X,
+                                             words, m_iNumWords,
+                                             pStatistics);
+    }
+
+    if (pStatistics) MergeStatistics(statistics);
+
+    Free(P);
+    Free(X);
+    Free(words);
+
+    return cliqueCount;
+}
+
+/*! \brief Recursively list all maximal cliques containing all of
+           all vertices in R, some vertices in P and no vertices in X.
+
+    \param cliqueCount A pointer to the number of maximal cliques computed 
+                       thus far.
+
+    \param partialClique A linked list storing R, the partial clique for this
+                         recursive call. 
+
+    \param P The bitset of candidates; modified by this call.
+
+    \param X The bitset of vertices already listed with R; modified by this call.
+
+    \param words The words in which P or X have set bits; P and X are
+                 undefined in other words.
+
+    \param numWords The number of entries in words.
+
+    \param pStatistics If non-null, delay statistics for this run are recorded here.
+*/
+
+void BitSetTomitaAlgorithm::listAllMaximalCliquesBitSetRecursive(long* cliqueCount,
+                                                                 list<int> &partialClique,
+                                                                 uint64_t* P, uint64_t* X,
+                                                                 int const* words, int numWords,
+                                                                 EnumerationStatistics* pStatistics)
+{
+    if (pStatistics) pStatistics->RecordNode(partialClique.size());
+
+    // if X is empty and P is empty, process partial clique as maximal
+    if (numWords == 0) {
+        (*cliqueCount)++;
+
+        if (pStatistics) pStatistics->RecordClique(partialClique.size());
+
+        ExecuteCallBacks(partialClique);
+        processClique(partialClique);
+
+        return;
+    }
+
+    size_t const depth(partialClique.size());
+    if (depth >= m_vScratch.size()) {
+        m_vScratch.push_back((uint64_t*)Calloc(3*static_cast<size_t>(m_iNumWords), sizeof(uint64_t)));
+        m_vWordScratch.push_back((int*)Calloc(2*static_cast<size_t>(m_iNumWords), sizeof(int)));
+    }
+
+    // words of P with set bits; the pivot computation only scans these
+    int* wordsOfP = m_vWordScratch[depth];
+    int* newWords = wordsOfP + m_iNumWords;
+    int numWordsOfP = 0;
+    int sizeOfP = 0;
+    for (int i = 0; i < numWords; i++) {
+        int const word = words[i];
+        if (P[word] != 0) {
+            wordsOfP[numWordsOfP++] = word;
+            sizeOfP += PopCount(P[word]);
+        }
+    }
+
+    // avoid work if P is empty.
+    if (sizeOfP == 0)
+        return;
+
+    // find the vertex in P union X with the most neighbors in P
+    int pivot = -1;
+    int maxIntersectionSize = -1;
+    for (int i = 0; i < numWords && maxIntersectionSize < sizeOfP; i++) {
+        int const word = words[i];
+        uint64_t remaining = P[word] | X[word];
+        while (remaining != 0 && maxIntersectionSize < sizeOfP) {
+            int const vertex = word*64 + LowestBit(remaining);
+            remaining &= (remaining - 1);
+
+            uint64_t const* neighbors = GetNeighbors(vertex);
+            int numNeighborsInP = 0;
+            for (int k = 0; k < numWordsOfP; k++) {
+                numNeighborsInP += PopCount(P[wordsOfP[k]] & neighbors[wordsOfP[k]]);
+            }
+
+            if (numNeighborsInP > maxIntersectionSize) {
+                pivot = vertex;
+                maxIntersectionSize = numNeighborsInP;
+            }
+        }
+    }
+
+    uint64_t* newP = m_vScratch[depth];
+    uint64_t* newX = newP + m_iNumWords;
+    uint64_t* candidates = newX + m_iNumWords;
+
+    // candidates are P \ N(pivot), taken before P changes below
+    uint64_t const* pivotNeighbors = GetNeighbors(pivot);
+    for (int k = 0; k < numWordsOfP; k++) {
+        candidates[k] = P[wordsOfP[k]] & ~pivotNeighbors[wordsOfP[k]];
+    }
+
+    // add candiate vertices to the partial clique one at a time and 
+    // search for maximal cliques
+    for (int k = 0; k < numWordsOfP; k++) {
+        int const word = wordsOfP[k];
+        uint64_t remaining = candidates[k];
+        while (remaining != 0) {
+            int const vertex = word*64 + LowestBit(remaining);
+            uint64_t const bit = remaining & (~remaining + 1);
+            remaining &= (remaining - 1);
+
+            #ifdef PRINT_CLIQUES_TOMITA_STYLE
+            printf("%d ", vertex);
+            #endif
+
+            // add vertex into partialClique, representing R.
+            partialClique.push_back(vertex);
+
+            // new P and X are P and X intersected with N(vertex), in
+            // the words where either is nonempty
+            uint64_t const* neighbors = GetNeighbors(vertex);
+            int numNewWords = 0;
+            for (int i = 0; i < numWords; i++) {
+                int const newWord = words[i];
+                newP[newWord] = P[newWord] & neighbors[newWord];
+                newX[newWord] = X[newWord] & neighbors[newWord];
+                if ((newP[newWord] | newX[newWord]) != 0) {
+                    newWords[numNewWords++] = newWord;
+                }
+            }
+
+            // recursively compute maximal cliques with new sets R, P and X
+            listAllMaximalCliquesBitSetRecursive(cliqueCount,
+                                                 partialClique,
+                                                 newP, newX,
+                                                 newWords, numNewWords,
+                                                 pStatistics);
+
+            #ifdef PRINT_CLIQUES_TOMITA_STYLE
+            printf("b ");
+            #endif
+
+            // remove vertex from partialClique, and move it from P to X
+            partialClique.pop_back();
+
+            P[word] &= ~bit;
+            X[word] |= bit;
+        }
+    }
+}
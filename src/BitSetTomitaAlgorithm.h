@@ -0,0 +1,67 @@
+#ifndef _DJS_BITSET_TOMITA_ALGORITHM_H_
+#define _DJS_BITSET_TOMITA_ALGORITHM_H_
+
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "Algorithm.h"
+#include "Tools.h"
+#include "MemoryManager.h"
+
+// system includes
+#include <cstdint>
+#include <list>
+#include <vector>
+
+/*! \file BitSetTomitaAlgorithm.h
+
+    \brief see BitSetTomitaAlgorithm.cpp
+*/
+
+class BitSetTomitaAlgorithm : public Algorithm
+{
+public:
+    //! graphs with at least this many vertices are refused, since the
+    //! matrix takes n^2/8 bytes.
+    static int const MAX_VERTICES = 60000;
+
+    BitSetTomitaAlgorithm(std::vector<std::list<int>> &&adjacencyList);
+    virtual ~BitSetTomitaAlgorithm();
+
+    virtual long Run(std::list<std::list<int>> &cliques);
+
+    BitSetTomitaAlgorithm           (BitSetTomitaAlgorithm const &) = delete;
+    BitSetTomitaAlgorithm& operator=(BitSetTomitaAlgorithm const &) = delete;
+
+    void listAllMaximalCliquesBitSetRecursive(long* cliqueCount,
+                                              std::list<int> &partialClique,
+                                              uint64_t* P, uint64_t* X,
+                                              int const* words, int numWords,
+                                              EnumerationStatistics* pStatistics);
+
+    long listAllMaximalCliquesBitSet();
+
+protected:
+    uint64_t const* GetNeighbors(int const vertex) const { return m_AdjacencyMatrix + static_cast<size_t>(vertex)*m_iNumWords; }
+
+    int m_iNumVertices;
+    int m_iNumWords; //!< the number of 64-bit words in a row of the matrix
+    uint64_t* m_AdjacencyMatrix;
+    std::vector<uint64_t*> m_vScratch;  //!< per depth: new P, new X, and candidates
+    std::vector<int*> m_vWordScratch;   //!< per depth: the words of P, and of new P union new X, with set bits
+};
+
+#endif
@@ -0,0 +1,301 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "Checkpoint.h"
+
+// system includes
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+/*! \file Checkpoint.cpp
+
+    \brief The progress of a run of qc, saved so that an interrupted run
+           can be resumed: the next root of the enumeration (a vertex id, as
+           roots are visited in increasing order of vertex id) and the
+           cliques of all earlier roots, or, once the enumeration is complete, the
+           position of the top-k selection and its incumbent solution.
+
+    Checkpoints are plain text, in two files: the state of the run,
+
+    \verbatim
+    qc-checkpoint 5
+    vertices <n>
+    edges <m>
+    K <K>
+    roots <first root> <one past the last root>
+    phase <enumeration|selection>
+    next_root <vertex id of the next root>
+    cliques <number of cliques> <bytes of the clique file>
+    next_selection_index <index>
+    incumbent <number of cliques> <clique index> <clique index> ...
+    \endverbatim
+
+    and, in the clique file (the name of the checkpoint plus ".cliques"),
+    one line per clique:
+
+    \verbatim
+    <size> <vertex> <vertex> ...
+    \endverbatim
+
+    The clique file only grows: each checkpoint appends the cliques found
+    since the previous one and flushes them to disk, so a checkpoint costs
+    time proportional to the new cliques, not to all of them. The state is
+    then written to a temporary file, flushed, and renamed over the
+    previous one, so a preempted run always leaves a complete checkpoint
+    behind; cliques appended after the last state are ignored by Load, and
+    overwritten by the next Save.
+
+    The last checkpoint of a run holds all of its cliques and its best
+    choice, so the checkpoints of the shards of a run (see Sharding.cpp)
+    are also their results, which bin/qc-merge combines.
+*/
+
+namespace
+{
+    char const *MAGIC = "qc-checkpoint";
+    int  const  VERSION = 5;
+
+    string GetCliquesFileName(string const &fileName)
+    {
+        return fileName + ".cliques";
+    }
+
+    void WriteCliques(FILE *file, CliqueStore const &cliques, size_t const begin)
+    {
+        vector<int> clique;
+        for (size_t i = begin; i < cliques.size(); ++i) {
+            cliques.GetClique(i, clique);
+            fprintf(file, "%zu", clique.size());
+            for (int const vertex : clique) {
+                fprintf(file, " %d", vertex);
+            }
+            fprintf(file, "\n");
+        }
+    }
+
+    bool ReadCliques(istream &in, size_t const numCliques, CliqueStore &cliques)
+    {
+        cliques.clear();
+        vector<int> clique;
+        for (size_t i = 0; i < numCliques; ++i) {
+            size_t size(0);
+            if (!(in >> size)) return false;
+            clique.resize(size);
+            for (size_t j = 0; j < size; ++j) {
+                if (!(in >> clique[j])) return false;
+            }
+            cliques.Add(clique.begin(), clique.end());
+        }
+        return true;
+    }
+
+    void WriteIndices(FILE *file, char const *name, vector<size_t> const &indices)
+    {
+        fprintf(file, "%s %zu", name, indices.size());
+        for (size_t const index : indices) {
+            fprintf(file, " %zu", index);
+        }
+        fprintf(file, "\n");
+    }
+
+    bool ReadIndices(istream &in, string const &expectedName, size_t const numCliques, vector<size_t> &indices)
+    {
+        string name;
+        size_t numIndices(0);
+        if (!(in >> name >> numIndices) || name != expectedName) return false;
+
+        indices.resize(numIndices);
+        for (size_t i = 0; i < numIndices; ++i) {
+            if (!(in >> indices[i]) || indices[i] >= numCliques) return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool ReadField(istream &in, string const &expectedName, T &value)
+    {
+        string name;
+        return (in >> name >> value) && name == expectedName;
+    }
+};
+
+Checkpoint::Checkpoint()
+ : m_lNumVertices(0)
+ , m_lNumEdges(0)
+ , m_iK(0)
+ , m_Phase(PHASE_ENUMERATION)
+ , m_iBeginRoot(0)
+ , m_iEndRoot(0)
+ , m_iNextRoot(0)
+ , m_vCliques()
+ , m_lNextSelectionIndex(0)
+ , m_vIncumbent()
+ , m_sSavedFileName()
+ , m_lNumSavedCliques(0)
+ , m_lSavedBytes(0)
+{
+}
+
+Checkpoint::~Checkpoint()
+{
+}
+
+/*! \brief atomically replace the checkpoint in fileName with this one.
+
+    \return true if the checkpoint was written.
+*/
+
+bool Checkpoint::Save(string const &fileName)
+{
+    return Save(fileName, m_vCliques);
+}
+
+/*! \brief append the cliques not saved yet to the clique file of
+           fileName, and flush them to disk.
+
+    The cliques saved before are the first ones of cliques, unless this
+    checkpoint was not saved to (or loaded from) fileName, or the clique
+    file is shorter than expected; then all cliques are written again.
+
+    \return true if the cliques were written.
+*/
+
+bool Checkpoint::AppendCliques(string const &fileName, CliqueStore const &cliques)
+{
+    string const cliquesFileName(GetCliquesFileName(fileName));
+    struct stat status;
+    if (fileName != m_sSavedFileName || m_lNumSavedCliques > static_cast<long>(cliques.size()) ||
+        stat(cliquesFileName.c_str(), &status) != 0 || status.st_size < m_lSavedBytes) {
+        m_lNumSavedCliques = 0;
+        m_lSavedBytes = 0;
+    }
+
+    // drop cliques appended after the last complete checkpoint
+    FILE *file = fopen(cliquesFileName.c_str(), (m_lSavedBytes == 0) ? "w" : "r+");
+    if (file == nullptr) return false;
+    if (ftruncate(fileno(file), m_lSavedBytes) != 0 || fseek(file, m_lSavedBytes, SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+
+    WriteCliques(file, cliques, m_lNumSavedCliques);
+
+    long const bytes(ftell(file));
+    bool const bWritten(fflush(file) == 0 && fsync(fileno(file)) == 0 && bytes >= 0);
+    if (fclose(file) != 0 || !bWritten) return false;
+
+    m_sSavedFileName   = fileName;
+    m_lNumSavedCliques = cliques.size();
+    m_lSavedBytes      = bytes;
+    return true;
+}
+
+/*! \brief atomically replace the checkpoint in fileName with this one,
+           with the given cliques instead of m_vCliques, which are only
+           read (e.g., while other threads read them too).
+
+    \return true if the checkpoint was written.
+*/
+
+bool Checkpoint::Save(string const &fileName, CliqueStore const &cliques)
+{
+    if (!AppendCliques(fileName, cliques)) return false;
+
+    string const temporaryFileName(fileName + ".tmp");
+    FILE *file = fopen(temporaryFileName.c_str(), "w");
+    if (file == nullptr) return false;
+
+    fprintf(file, "%s %d\n", MAGIC, VERSION);
+    fprintf(file, "vertices %ld\n", m_lNumVertices);
+    fprintf(file, "edges %ld\n", m_lNumEdges);
+    fprintf(file, "K %d\n", m_iK);
+    fprintf(file, "roots %d %d\n", m_iBeginRoot, m_iEndRoot);
+    fprintf(file, "phase %s\n", (m_Phase == PHASE_ENUMERATION) ? "enumeration" : "selection");
+    fprintf(file, "next_root %d\n", m_iNextRoot);
+    fprintf(file, "cliques %ld %ld\n", m_lNumSavedCliques, m_lSavedBytes);
+    fprintf(file, "next_selection_index %ld\n", m_lNextSelectionIndex);
+    WriteIndices(file, "incumbent", m_vIncumbent);
+
+    bool const bWritten(fflush(file) == 0 && fsync(fileno(file)) == 0);
+    if (fclose(file) != 0 || !bWritten) {
+        remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    return rename(temporaryFileName.c_str(), fileName.c_str()) == 0;
+}
+
+/*! \brief whether the run that wrote this checkpoint was complete.
+*/
+
+bool Checkpoint::IsComplete() const
+{
+    return m_Phase == PHASE_SELECTION && m_lNextSelectionIndex >= static_cast<long>(m_vCliques.size());
+}
+
+/*! \brief read a checkpoint written by Save.
+
+    \return true if fileName holds a complete checkpoint.
+*/
+
+bool Checkpoint::Load(string const &fileName)
+{
+    ifstream in(fileName.c_str());
+    if (!in.good()) return false;
+
+    string magic;
+    int version(0);
+    if (!(in >> magic >> version) || magic != MAGIC || version != VERSION) return false;
+
+    string phase;
+    if (!ReadField(in, "vertices", m_lNumVertices) ||
+        !ReadField(in, "edges", m_lNumEdges) ||
+        !ReadField(in, "K", m_iK) ||
+        !ReadField(in, "roots", m_iBeginRoot) || !(in >> m_iEndRoot) ||
+        !ReadField(in, "phase", phase)) {
+        return false;
+    }
+
+    if (phase == "enumeration") {
+        m_Phase = PHASE_ENUMERATION;
+    } else if (phase == "selection") {
+        m_Phase = PHASE_SELECTION;
+    } else {
+        return false;
+    }
+
+    long numCliques(0), bytes(0);
+    if (!ReadField(in, "next_root", m_iNextRoot) ||
+        !ReadField(in, "cliques", numCliques) || !(in >> bytes) ||
+        !ReadField(in, "next_selection_index", m_lNextSelectionIndex) ||
+        !ReadIndices(in, "incumbent", numCliques, m_vIncumbent)) {
+        return false;
+    }
+
+    ifstream cliquesIn(GetCliquesFileName(fileName).c_str());
+    if (!cliquesIn.good() || !ReadCliques(cliquesIn, numCliques, m_vCliques)) return false;
+
+    // the next Save to fileName appends to the cliques read here
+    m_sSavedFileName   = fileName;
+    m_lNumSavedCliques = numCliques;
+    m_lSavedBytes      = bytes;
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "CliqueStore.h"
+
+// system includes
+#include <string>
+#include <vector>
+
+/*! \file Checkpoint.h
+
+    \brief see Checkpoint.cpp
+*/
+
+class Checkpoint
+{
+public:
+    enum Phase
+    {
+        PHASE_ENUMERATION = 0,
+        PHASE_SELECTION
+    };
+
+    Checkpoint();
+    ~Checkpoint();
+
+    bool Save(std::string const &fileName);
+    bool Save(std::string const &fileName, CliqueStore const &cliques);
+    bool Load(std::string const &fileName);
+
+    bool IsComplete() const;
+
+    // the run this checkpoint belongs to
+    long m_lNumVertices;
+    long m_lNumEdges;
+    int  m_iK;
+
+    Phase m_Phase;
+
+    // the roots [m_iBeginRoot, m_iEndRoot) of this run, or of its shard
+    int m_iBeginRoot;
+    int m_iEndRoot;
+
+    // enumeration: the cliques of all roots (vertex ids) before m_iNextRoot
+    int  m_iNextRoot;
+    CliqueStore m_vCliques;
+
+    // selection: the indices of the cliques of the incumbent, over all
+    // choices whose first clique comes before position
+    // m_lNextSelectionIndex of the search order (largest cliques first)
+    long m_lNextSelectionIndex;
+    std::vector<size_t> m_vIncumbent;
+
+private:
+    bool AppendCliques(std::string const &fileName, CliqueStore const &cliques);
+
+    // the cliques already in the clique file of m_sSavedFileName
+    std::string m_sSavedFileName;
+    long m_lNumSavedCliques;
+    long m_lSavedBytes;
+};
+
+#endif //CHECKPOINT_H
@@ -0,0 +1,107 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "CliqueBitsets.h"
+
+// system includes
+#include <algorithm>
+
+using namespace std;
+
+/*! \file CliqueBitsets.cpp
+
+    \brief Each candidate clique of the top-k selection as a bitset over the
+           active vertices, i.e., the vertices of at least one candidate
+           clique, numbered consecutively.
+
+    The vertices covered by a choice of cliques are the OR of their
+    bitsets, so the coverage of a choice, and the gain of adding a clique,
+    take a popcount per word instead of a walk up the clique store and a
+    counter per vertex. Vertices are numbered in the order the cliques
+    list them, and consecutive cliques share most vertices, so a clique
+    spans few words; only its nonzero words are kept, contiguously, so
+    adding a clique costs at most one word per vertex, however many
+    vertices are active.
+*/
+
+CliqueBitsets::CliqueBitsets()
+ : m_iNumActive(0)
+ , m_MaxNumWords(0)
+ , m_vOrder()
+ , m_vOffsets()
+ , m_vWordIndices()
+ , m_vWords()
+{
+}
+
+CliqueBitsets::~CliqueBitsets()
+{
+}
+
+/*! \brief build the bitsets of all cliques, in the order of the clique
+           store.
+*/
+
+void CliqueBitsets::Build(CliqueStore const &cliques, int const numVertices)
+{
+    vector<size_t> order(cliques.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    Build(cliques, numVertices, order);
+}
+
+/*! \brief build the bitsets of all cliques; the bitset at index i is that
+           of the clique at index order[i] of the clique store.
+
+    Vertices are numbered in the order of the clique store whatever the
+    order of the bitsets, so each clique spans as few words as it can.
+*/
+
+void CliqueBitsets::Build(CliqueStore const &cliques, int const numVertices, vector<size_t> const &order)
+{
+    m_iNumActive = 0;
+    m_MaxNumWords = 0;
+    m_vOrder = order;
+    m_vOffsets.assign(1, 0);
+    m_vWordIndices.clear();
+    m_vWords.clear();
+
+    vector<int> compact(numVertices, -1);
+    for (size_t i = 0; i < cliques.size(); ++i) {
+        cliques.ForEachVertex(i, [this, &compact](int const vertex) {
+            if (compact[vertex] < 0) compact[vertex] = m_iNumActive++;
+        });
+    }
+
+    vector<int> bits;
+    for (size_t const index : order) {
+        bits.clear();
+        cliques.ForEachVertex(index, [&compact, &bits](int const vertex) {
+            bits.push_back(compact[vertex]);
+        });
+        sort(bits.begin(), bits.end());
+
+        for (int const bit : bits) {
+            uint32_t const wordIndex(bit/64);
+            if (m_vWords.size() == m_vOffsets.back() || m_vWordIndices.back() != wordIndex) {
+                m_vWordIndices.push_back(wordIndex);
+                m_vWords.push_back(0);
+            }
+            m_vWords.back() |= (static_cast<uint64_t>(1) << (bit%64));
+        }
+        m_MaxNumWords = max(m_MaxNumWords, m_vWords.size() - m_vOffsets.back());
+        m_vOffsets.push_back(m_vWords.size());
+    }
+}
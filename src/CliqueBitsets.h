@@ -0,0 +1,132 @@
+#ifndef CLIQUE_BITSETS_H
+#define CLIQUE_BITSETS_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "CliqueStore.h"
+
+// system includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*! \file CliqueBitsets.h
+
+    \brief see CliqueBitsets.cpp
+*/
+
+class CliqueBitsets
+{
+public:
+    /*! \brief the number of bits set in a word. Without the popcnt
+               instruction (-mpopcnt), __builtin_popcountll is a library
+               call, which costs more than the rest of Add.
+    */
+    static inline int PopCount(uint64_t word)
+    {
+#ifdef __POPCNT__
+        return __builtin_popcountll(word);
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    CliqueBitsets();
+    ~CliqueBitsets();
+
+    /*! \brief an upper bound on the memory Build takes for numCliques cliques
+               with numEntries vertices in all: a clique has at most one
+               nonzero word per vertex.
+    */
+    static size_t GetMaxBytes(size_t const numCliques, size_t const numEntries, int const numVertices)
+    {
+        return numEntries*(sizeof(uint64_t) + sizeof(uint32_t)) + numCliques*2*sizeof(size_t) + numVertices*sizeof(int);
+    }
+
+    void Build(CliqueStore const &cliques, int const numVertices);
+    void Build(CliqueStore const &cliques, int const numVertices, std::vector<size_t> const &order);
+
+    //! the number of bitsets, one per clique
+    size_t size() const { return m_vOrder.size(); }
+
+    //! the index, in the clique store, of the clique of the bitset at index
+    size_t GetCliqueIndex(size_t const index) const { return m_vOrder[index]; }
+
+    //! the number of words of a bitset of all active vertices
+    int GetNumWords() const  { return (m_iNumActive + 63)/64; }
+    int GetNumActive() const { return m_iNumActive; }
+
+    //! the number of nonzero words of a clique
+    size_t GetNumWords(size_t const index) const { return m_vOffsets[index + 1] - m_vOffsets[index]; }
+
+    //! the largest number of nonzero words of a clique
+    size_t GetMaxNumWords() const { return m_MaxNumWords; }
+
+    //! the positions of the nonzero words of a clique, in increasing order
+    uint32_t const *GetWordIndices(size_t const index) const { return m_vWordIndices.data() + m_vOffsets[index]; }
+
+    //! the nonzero words of a clique
+    uint64_t const *GetWords(size_t const index) const { return m_vWords.data() + m_vOffsets[index]; }
+
+    /*! \brief covered |= the clique, saving the GetNumWords(index) words it
+               changes in undo.
+
+        \return the number of vertices newly covered.
+    */
+    int Add(size_t const index, uint64_t *covered, uint64_t *undo) const
+    {
+        int count(0);
+        for (size_t i = m_vOffsets[index]; i < m_vOffsets[index + 1]; ++i) {
+            uint64_t &word(covered[m_vWordIndices[i]]);
+            *undo++ = word;
+            count += PopCount(m_vWords[i] & ~word);
+            word |= m_vWords[i];
+        }
+        return count;
+    }
+
+    //! undoes the last Add of the clique at index, with the same undo
+    void Remove(size_t const index, uint64_t *covered, uint64_t const *undo) const
+    {
+        for (size_t i = m_vOffsets[index]; i < m_vOffsets[index + 1]; ++i) {
+            covered[m_vWordIndices[i]] = *undo++;
+        }
+    }
+
+    //! the number of vertices of a clique that are not in covered
+    int Gain(size_t const index, uint64_t const *covered) const
+    {
+        int count(0);
+        for (size_t i = m_vOffsets[index]; i < m_vOffsets[index + 1]; ++i) {
+            count += PopCount(m_vWords[i] & ~covered[m_vWordIndices[i]]);
+        }
+        return count;
+    }
+
+private:
+    int m_iNumActive;
+    size_t m_MaxNumWords;
+    std::vector<size_t> m_vOrder;         //!< the clique of each bitset
+    std::vector<size_t> m_vOffsets;       //!< the words of clique i are [m_vOffsets[i], m_vOffsets[i+1])
+    std::vector<uint32_t> m_vWordIndices; //!< the position of each word in a bitset of all active vertices
+    std::vector<uint64_t> m_vWords;       //!< the nonzero words of each clique
+};
+
+#endif //CLIQUE_BITSETS_H
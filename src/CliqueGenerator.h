@@ -0,0 +1,92 @@
+#ifndef CLIQUE_GENERATOR_H
+#define CLIQUE_GENERATOR_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <cstddef>
+#include <vector>
+
+/*! \file CliqueGenerator.h
+
+    \brief A pull-style interface to a clique enumeration: the consumer asks
+           for one clique at a time, and may stop the enumeration early,
+           paying only for the cliques it consumes.
+*/
+
+/*! \brief a read-only view of the vertices of a clique. It is valid until
+           the next call to CliqueGenerator::Next or CliqueGenerator::Stop.
+*/
+
+class CliqueSpan
+{
+public:
+    CliqueSpan() : m_pBegin(nullptr), m_Size(0) {}
+    CliqueSpan(int const *begin, size_t const size) : m_pBegin(begin), m_Size(size) {}
+
+    int const *begin() const { return m_pBegin; }
+    int const *end()   const { return m_pBegin + m_Size; }
+    int const *data()  const { return m_pBegin; }
+    size_t     size()  const { return m_Size; }
+    bool       empty() const { return m_Size == 0; }
+    int operator[](size_t const index) const { return m_pBegin[index]; }
+
+private:
+    int const *m_pBegin;
+    size_t m_Size;
+};
+
+class CliqueGenerator
+{
+public:
+    virtual ~CliqueGenerator() {}
+
+    //! fills clique with the next maximal clique, and returns true, or
+    //! returns false if the enumeration is complete or was stopped.
+    virtual bool Next(CliqueSpan &clique) = 0;
+
+    //! ends the enumeration and releases its working memory; Next returns
+    //! false afterwards.
+    virtual void Stop() = 0;
+
+    //! the number of cliques returned by Next so far.
+    virtual long GetCliqueCount() const = 0;
+
+    //! the root of the search tree that contains the last clique returned
+    //! by Next; the cliques of all earlier roots have been returned.
+    virtual int GetCurrentRoot() const = 0;
+
+    //! restarts the enumeration at the given root, counting cliqueCount
+    //! cliques for the earlier roots, e.g., to continue from a checkpoint.
+    virtual void Resume(int nextRoot, long cliqueCount) = 0;
+
+    //! the number of roots, i.e., of independent search trees.
+    virtual int GetNumRoots() const = 0;
+
+    //! restricts the enumeration to the roots in [beginRoot, endRoot),
+    //! e.g., to split one enumeration across processes.
+    virtual void SetRootRange(int beginRoot, int endRoot) = 0;
+
+    //! a relative estimate of the work of each root.
+    virtual std::vector<double> EstimateRootCosts() const = 0;
+
+    //! allows the enumeration to skip every clique of at most threshold
+    //! vertices, e.g., cliques that cannot be among the largest; the
+    //! threshold may be raised between calls to Next.
+    virtual void SetSizeThreshold(size_t threshold) = 0;
+};
+
+#endif //CLIQUE_GENERATOR_H
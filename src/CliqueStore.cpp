@@ -0,0 +1,212 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "CliqueStore.h"
+
+// system includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+
+/*! \file CliqueStore.cpp
+
+    \brief Store maximal cliques as the recursion tree that found them.
+
+    Consecutive cliques of a depth-first search share the partial clique
+    up to the node where the search branched, and all cliques of a root
+    start with the root. So instead of a copy of each clique, the store
+    keeps one node per vertex of the recursion tree, with its vertex and
+    its parent, and each clique is the node of its last vertex. A clique
+    is added by following the nodes of the previous clique while the
+    vertices agree, and adding nodes for the rest.
+
+    Cliques are reconstructed on demand, by following parent pointers,
+    which visits the vertices of a clique as fast as a linked list, in
+    about 8 bytes per node instead of a list node per vertex. Cliques that
+    are not found in depth-first order are stored correctly, but share
+    less.
+
+    When the cliques do not fit in memory, or should be kept for later
+    runs, they are stored on disk instead, see DiskCliqueStore.cpp. A store
+    with a spill limit moves to disk by itself once it outgrows the limit.
+*/
+
+CliqueStore::CliqueStore()
+ : m_vParent(1, ROOT)
+ , m_vVertex(1, -1)
+ , m_vLeaves()
+ , m_vPath()
+ , m_pDisk(nullptr)
+ , m_sSpillDirectory()
+ , m_SpillLimitBytes(0)
+{
+}
+
+CliqueStore::~CliqueStore()
+{
+    delete m_pDisk;
+}
+
+/*! \brief move the cliques in memory to a new store on disk, where all
+           further cliques are added.
+*/
+
+bool CliqueStore::MoveToDisk(string const &directory, bool const bTemporary, size_t const segmentBytes)
+{
+    DiskCliqueStore *pDisk(new DiskCliqueStore());
+    if (!pDisk->Create(directory, bTemporary, segmentBytes)) {
+        delete pDisk;
+        return false;
+    }
+
+    vector<int> clique;
+    for (size_t i = 0; i < size(); ++i) {
+        GetClique(i, clique);
+        pDisk->Add(clique.begin(), clique.end());
+    }
+
+    CliqueStore empty;
+    swap(empty);
+    m_pDisk = pDisk;
+    return true;
+}
+
+/*! \brief store the cliques on disk, in a directory that is kept, see
+           DiskCliqueStore::Create. Cliques already in memory are moved there.
+*/
+
+bool CliqueStore::CreateOnDisk(string const &directory)
+{
+    if (m_pDisk != nullptr) return false;
+    return MoveToDisk(directory, false, DiskCliqueStore::SEGMENT_BYTES);
+}
+
+/*! \brief replace the cliques with those of a complete store on disk.
+
+    \return true if directory holds a complete store.
+*/
+
+bool CliqueStore::OpenOnDisk(string const &directory)
+{
+    DiskCliqueStore *pDisk(new DiskCliqueStore());
+    if (!pDisk->Open(directory)) {
+        delete pDisk;
+        return false;
+    }
+
+    CliqueStore().swap(*this);
+    m_pDisk = pDisk;
+    return true;
+}
+
+/*! \brief move the cliques to a temporary store on disk, in a new directory
+           in the given directory, once they take more than limitBytes of
+           memory.
+
+    The store on disk then keeps less than limitBytes in memory, so the limit
+    bounds the memory of the cliques while they are enumerated. The top-k
+    selection keeps the bitsets of the cliques within the same limit, see
+    TopKSelection::SelectBranchAndBound, but not its other structures.
+*/
+
+void CliqueStore::SetSpill(string const &directory, size_t const limitBytes)
+{
+    m_sSpillDirectory = directory;
+    m_SpillLimitBytes = limitBytes;
+}
+
+void CliqueStore::SpillToDisk()
+{
+    char name[32];
+    snprintf(name, sizeof(name), "/qc-spill-%ld", static_cast<long>(getpid()));
+    string const directory(m_sSpillDirectory + name);
+
+    fprintf(stderr, "NOTE: the clique store outgrew %zu MB, moving %zu cliques to %s\n",
+            m_SpillLimitBytes >> 20, size(), directory.c_str());
+    // the store on disk keeps about two segments in memory
+    size_t const segmentBytes(max(m_SpillLimitBytes / 4, static_cast<size_t>(1) << 16));
+    if (!MoveToDisk(directory, true, segmentBytes)) {
+        fprintf(stderr, "ERROR: unable to create the clique store in %s\n", directory.c_str());
+        exit(1);
+    }
+}
+
+/*! \brief complete a store on disk; a store in memory is always complete.
+
+    \return true if all cliques were written.
+*/
+
+bool CliqueStore::Finish()
+{
+    return (m_pDisk == nullptr) || m_pDisk->Finish();
+}
+
+uint32_t CliqueStore::NewNode(uint32_t const parent, int const vertex)
+{
+    if (m_vParent.size() > UINT32_MAX) {
+        fprintf(stderr, "ERROR: too many vertices in the clique store\n");
+        exit(1);
+    }
+    m_vParent.push_back(parent);
+    m_vVertex.push_back(vertex);
+    return static_cast<uint32_t>(m_vParent.size() - 1);
+}
+
+/*! \brief reconstruct a clique: in memory, in the order its vertices were
+           added to the partial clique, and on disk, which keeps no such
+           order, in increasing order.
+*/
+
+void CliqueStore::GetClique(size_t const index, vector<int> &clique) const
+{
+    clique.clear();
+    ForEachVertex(index, [&clique](int const vertex) { clique.push_back(vertex); });
+    // in memory, the vertices come from the last one added to the first
+    if (m_pDisk == nullptr) reverse(clique.begin(), clique.end());
+}
+
+size_t CliqueStore::GetCliqueSize(size_t const index) const
+{
+    size_t size(0);
+    ForEachVertex(index, [&size](int) { size++; });
+    return size;
+}
+
+void CliqueStore::clear()
+{
+    CliqueStore().swap(*this);
+}
+
+void CliqueStore::swap(CliqueStore &other)
+{
+    m_vParent.swap(other.m_vParent);
+    m_vVertex.swap(other.m_vVertex);
+    m_vLeaves.swap(other.m_vLeaves);
+    m_vPath.swap(other.m_vPath);
+    std::swap(m_pDisk, other.m_pDisk);
+    m_sSpillDirectory.swap(other.m_sSpillDirectory);
+    std::swap(m_SpillLimitBytes, other.m_SpillLimitBytes);
+}
+
+size_t CliqueStore::GetMemoryBytes() const
+{
+    return ((m_pDisk != nullptr) ? m_pDisk->GetMemoryBytes() : 0)
+         + m_vParent.capacity() * sizeof(uint32_t) + m_vVertex.capacity() * sizeof(int)
+         + m_vLeaves.capacity() * sizeof(uint32_t) + m_vPath.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,132 @@
+#ifndef CLIQUE_STORE_H
+#define CLIQUE_STORE_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "DiskCliqueStore.h"
+
+// system includes
+#include <cstddef>
+#include <string>
+#include <cstdint>
+#include <vector>
+
+/*! \file CliqueStore.h
+
+    \brief see CliqueStore.cpp
+*/
+
+class CliqueStore
+{
+public:
+    CliqueStore();
+    ~CliqueStore();
+
+    CliqueStore           (CliqueStore const &) = delete;
+    CliqueStore& operator=(CliqueStore const &) = delete;
+
+    bool CreateOnDisk(std::string const &directory);
+    bool OpenOnDisk(std::string const &directory);
+    void SetSpill(std::string const &directory, size_t const limitBytes);
+    bool Finish();
+
+    bool IsOnDisk() const { return m_pDisk != nullptr; }
+    DiskCliqueStore &GetDiskStore() { return *m_pDisk; }
+    DiskCliqueStore const &GetDiskStore() const { return *m_pDisk; }
+
+    /*! \brief add a clique, given by its vertices in the order they were
+               added to the partial clique.
+
+        \return the index of the clique.
+    */
+    template <typename Iterator>
+    size_t Add(Iterator begin, Iterator end)
+    {
+        if (m_pDisk != nullptr) {
+            m_pDisk->Add(begin, end);
+            return m_pDisk->size() - 1;
+        }
+
+        // share the prefix of the previous clique
+        size_t depth(0);
+        Iterator it(begin);
+        while (it != end && depth < m_vPath.size() && m_vVertex[m_vPath[depth]] == *it) {
+            ++it;
+            ++depth;
+        }
+        m_vPath.resize(depth);
+
+        uint32_t node(m_vPath.empty() ? ROOT : m_vPath.back());
+        for (; it != end; ++it) {
+            node = NewNode(node, *it);
+            m_vPath.push_back(node);
+        }
+
+        m_vLeaves.push_back(node);
+        if (m_SpillLimitBytes > 0 && GetMemoryBytes() > m_SpillLimitBytes) SpillToDisk();
+        return m_vLeaves.size() - 1;
+    }
+
+    /*! \brief call function on each vertex of a clique: in memory, from the
+               last vertex added to the partial clique to the first, and on
+               disk, in increasing order.
+    */
+    template <typename Function>
+    void ForEachVertex(size_t const index, Function function) const;
+
+    void GetClique(size_t const index, std::vector<int> &clique) const;
+    size_t GetCliqueSize(size_t const index) const;
+
+    size_t size() const  { return (m_pDisk != nullptr) ? m_pDisk->size() : m_vLeaves.size(); }
+    bool   empty() const { return size() == 0; }
+    void   clear();
+    void   swap(CliqueStore &other);
+
+    size_t GetNumNodes() const { return m_vParent.size() - 1; }
+    size_t GetMemoryBytes() const;
+
+private:
+    //! the node above all first vertices; it has no vertex
+    static uint32_t const ROOT = 0;
+
+    uint32_t NewNode(uint32_t const parent, int const vertex);
+    bool MoveToDisk(std::string const &directory, bool const bTemporary, size_t const segmentBytes);
+    void SpillToDisk();
+
+    std::vector<uint32_t> m_vParent; //!< the parent of each node
+    std::vector<int>      m_vVertex; //!< the vertex of each node
+    std::vector<uint32_t> m_vLeaves; //!< the node of the last vertex of each clique
+    std::vector<uint32_t> m_vPath;   //!< the nodes of the last clique added
+
+    DiskCliqueStore *m_pDisk;        //!< if set, the cliques are stored on disk
+    std::string m_sSpillDirectory;
+    size_t m_SpillLimitBytes;        //!< move to disk above this size, if nonzero
+};
+
+template <typename Function>
+void CliqueStore::ForEachVertex(size_t const index, Function function) const
+{
+    if (m_pDisk != nullptr) {
+        m_pDisk->ForEachVertex(index, function);
+        return;
+    }
+    for (uint32_t node = m_vLeaves[index]; node != ROOT; node = m_vParent[node]) {
+        function(m_vVertex[node]);
+    }
+}
+
+#endif //CLIQUE_STORE_H
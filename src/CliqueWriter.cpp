@@ -0,0 +1,156 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "CliqueWriter.h"
+#include "Varint.h"
+
+using namespace std;
+
+/*! \file CliqueWriter.cpp
+
+    \brief Write maximal cliques to a file, through a large buffer that is
+           written out in one call when full, so that writing many cliques
+           is bounded by the disk rather than by per-vertex stdio calls.
+
+    The vertices of each clique are written in increasing order, in one of
+    two formats:
+
+     - text: one clique per line, the vertices separated by spaces.
+     - binary: the four bytes "QCB1", followed by one record per clique:
+       the number of vertices, the first vertex, and then the difference
+       of each vertex to the previous one, each as a varint (see Varint.h).
+*/
+
+char const CliqueWriter::MAGIC[4] = {'Q', 'C', 'B', '1'};
+
+namespace
+{
+    //! the most bytes needed to write a 32-bit value as a varint, or as
+    //! decimal digits and a separator
+    size_t const MAX_BYTES_PER_VALUE = 11;
+};
+
+CliqueWriter::CliqueWriter()
+ : m_pFile(nullptr)
+ , m_Format(FORMAT_TEXT)
+ , m_vBuffer()
+ , m_Used(0)
+ , m_vClique()
+ , m_lNumCliques(0)
+ , m_bFailed(false)
+{
+}
+
+CliqueWriter::~CliqueWriter()
+{
+    Close();
+}
+
+bool CliqueWriter::ParseFormat(string const &name, Format &format)
+{
+    if (name == "text") {
+        format = FORMAT_TEXT;
+    } else if (name == "binary") {
+        format = FORMAT_BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/*! \brief start writing cliques to a file, replacing its contents.
+
+    \return true if the file was opened.
+*/
+
+bool CliqueWriter::Open(string const &fileName, Format const format)
+{
+    Close();
+
+    m_pFile = fopen(fileName.c_str(), "wb");
+    if (m_pFile == nullptr) return false;
+
+    // the buffer replaces the one of stdio
+    setvbuf(m_pFile, nullptr, _IONBF, 0);
+
+    m_Format = format;
+    m_vBuffer.resize(BUFFER_SIZE);
+    m_Used = 0;
+    m_lNumCliques = 0;
+    m_bFailed = false;
+
+    if (m_Format == FORMAT_BINARY) {
+        for (char const c : MAGIC) m_vBuffer[m_Used++] = c;
+    }
+    return true;
+}
+
+/*! \brief write out the buffer, and close the file.
+
+    \return true if all cliques were written.
+*/
+
+bool CliqueWriter::Close()
+{
+    if (m_pFile == nullptr) return !m_bFailed;
+
+    Flush();
+    if (fclose(m_pFile) != 0) m_bFailed = true;
+    m_pFile = nullptr;
+    vector<char>().swap(m_vBuffer);
+    return !m_bFailed;
+}
+
+void CliqueWriter::Flush()
+{
+    if (m_Used == 0) return;
+    if (fwrite(m_vBuffer.data(), 1, m_Used, m_pFile) != m_Used) m_bFailed = true;
+    m_Used = 0;
+}
+
+void CliqueWriter::WriteText()
+{
+    for (size_t i = 0; i < m_vClique.size(); ++i) {
+        Reserve(MAX_BYTES_PER_VALUE);
+
+        // format the digits backwards, then copy them in order
+        char digits[MAX_BYTES_PER_VALUE];
+        int numDigits(0);
+        uint32_t value(m_vClique[i]);
+        do {
+            digits[numDigits++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        if (i != 0) m_vBuffer[m_Used++] = ' ';
+        while (numDigits > 0) m_vBuffer[m_Used++] = digits[--numDigits];
+    }
+    Reserve(1);
+    m_vBuffer[m_Used++] = '\n';
+}
+
+void CliqueWriter::WriteBinary()
+{
+    Reserve(MAX_BYTES_PER_VALUE);
+    Varint::Put(m_vBuffer.data(), m_Used, static_cast<uint32_t>(m_vClique.size()));
+
+    uint32_t previous(0);
+    for (int const vertex : m_vClique) {
+        Reserve(MAX_BYTES_PER_VALUE);
+        Varint::Put(m_vBuffer.data(), m_Used, static_cast<uint32_t>(vertex) - previous);
+        previous = static_cast<uint32_t>(vertex);
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef CLIQUE_WRITER_H
+#define CLIQUE_WRITER_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*! \file CliqueWriter.h
+
+    \brief see CliqueWriter.cpp
+*/
+
+class CliqueWriter
+{
+public:
+    enum Format
+    {
+        FORMAT_TEXT = 0,
+        FORMAT_BINARY
+    };
+
+    //! the size of the output buffer, in bytes
+    static size_t const BUFFER_SIZE = 1 << 22;
+
+    //! the first bytes of a binary clique file
+    static char const MAGIC[4];
+
+    CliqueWriter();
+    ~CliqueWriter();
+
+    CliqueWriter           (CliqueWriter const &) = delete;
+    CliqueWriter& operator=(CliqueWriter const &) = delete;
+
+    static bool ParseFormat(std::string const &name, Format &format);
+
+    bool Open(std::string const &fileName, Format const format);
+    bool Close();
+    bool IsOpen() const { return m_pFile != nullptr; }
+
+    /*! \brief write a clique, given by a range of vertices in any order.
+    */
+    template <typename Iterator>
+    void Write(Iterator begin, Iterator end)
+    {
+        m_vClique.assign(begin, end);
+        std::sort(m_vClique.begin(), m_vClique.end());
+        if (m_Format == FORMAT_BINARY) {
+            WriteBinary();
+        } else {
+            WriteText();
+        }
+        m_lNumCliques++;
+    }
+
+    long GetNumCliques() const { return m_lNumCliques; }
+
+private:
+    void WriteText();
+    void WriteBinary();
+    void Flush();
+
+    //! make room for at least size bytes in the buffer
+    inline void Reserve(size_t const size)
+    {
+        if (m_vBuffer.size() - m_Used < size) Flush();
+    }
+
+    FILE *m_pFile;
+    Format m_Format;
+    std::vector<char> m_vBuffer;
+    size_t m_Used;           //!< the number of bytes of m_vBuffer in use
+    std::vector<int> m_vClique;
+    long m_lNumCliques;
+    bool m_bFailed;          //!< a write failed
+};
+
+#endif //CLIQUE_WRITER_H
@@ -0,0 +1,297 @@
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "ComplementAlgorithm.h"
+#include "Tools.h"
+#include "MemoryManager.h"
+
+// system includes
+#include <cstdio>
+#include <list>
+#include <vector>
+
+using namespace std;
+
+/*! \file ComplementAlgorithm.cpp
+
+    \brief This file contains the algorithm of Tomita et al. (TCS 2006) for
+           listing all maximal cliques of the complement of the input graph,
+           that is, all maximal independent sets of the input graph, without
+           computing the complement.
+
+    As in AdjacencyListAlgorithm, the sets X and P are consecutive ranges
+    of one array of all vertices, vertexSets, and vertexLookup gives the
+    index of each vertex in it. The neighborhood of a vertex v in the
+    complement is every vertex except v and its neighbors in the input
+    graph. So:
+
+     - P and X intersected with the complemented neighborhood of v are
+       the ranges left after swapping v and its neighbors in P to the end
+       of P, and its neighbors in X to the start of X, which costs
+       O(degree of v). The range of X also holds vertices of P of the
+       search nodes above, so the swaps in X are undone when the child
+       search is done; the ones in P are not, since P stays within the P
+       of every search node above.
+
+     - the number of complement neighbors of u in P is |P| minus the
+       neighbors of u in P (and minus u, if it is in P), so the pivot,
+       which maximizes it, is found by scanning the sparse neighborhoods.
+
+     - the candidates P \ N(pivot), taken in the complement, are the
+       vertices of P among pivot and its neighbors in the input graph,
+       visited through the adjacency list of the pivot.
+
+    The search runs on an explicit stack of frames of six integers. The
+    depth of the search is the size of the largest maximal independent
+    set it reaches, which may be close to n for a sparse graph, so memory
+    is O(n + m) for the graph and the sets, plus O(n) for the stack, R,
+    and the swaps to undo (a vertex leaves X at most once on the way
+    down); neither the complement, which has O(n^2) edges for a sparse
+    graph, nor a copy of P and X per level is stored.
+*/
+
+ComplementAlgorithm::ComplementAlgorithm(vector<list<int>> &&adjacencyList)
+ : AdjacencyListAlgorithm(std::move(adjacencyList))
+ , m_pVertexSets(nullptr)
+ , m_pVertexLookup(nullptr)
+ , m_vFrames()
+ , m_vMovedFrom()
+{
+    SetName("complement");
+}
+
+ComplementAlgorithm::~ComplementAlgorithm()
+{
+}
+
+long ComplementAlgorithm::Run(list<list<int>> &cliques)
+{
+    return listAllMaximalCliquesComplement();
+}
+
+/*! \brief List all maximal cliques in the complement of the graph, using
+           the algorithm by Tomita et al. (TCS 2006).
+
+    \return the number of maximal cliques of the complement of the input graph.
+*/
+
+long ComplementAlgorithm::listAllMaximalCliquesComplement()
+{
+    // initially, all vertices are in P
+    m_pVertexSets   = (int*)Calloc(m_iNumVertices, sizeof(int));
+    m_pVertexLookup = (int*)Calloc(m_iNumVertices, sizeof(int));
+
+    for (int vertex = 0; vertex < m_iNumVertices; vertex++) {
+        m_pVertexSets[vertex]   = vertex;
+        m_pVertexLookup[vertex] = vertex;
+    }
+
+    long cliqueCount = 0;
+
+    list<int> partialClique;
+
+    // statistics are gathered locally, and published when the run completes
+    EnumerationStatistics statistics;
+    EnumerationStatistics* pStatistics = GetCollectStatistics() ? &statistics : nullptr;
+    ClearStatistics();
+    if (pStatistics) pStatistics->Start();
+
+    m_vFrames.clear();
+    m_vMovedFrom.clear();
+    if (m_iNumVertices > 0) {
+        pushFrameComplement(&cliqueCount, 0, 0, m_iNumVertices, partialClique, pStatistics);
+    }
+
+    while (!m_vFrames.empty()) {
+        Frame &frame(m_vFrames.back());
+
+        // the next candidate: a vertex of P among pivot and its neighbors;
+        // the candidates already searched have moved to X
+        int vertex = -1;
+        while (vertex < 0 && frame.cursor < m_Degree[frame.pivot]) {
+            int const next = (frame.cursor < 0) ? frame.pivot : m_AdjacencyList[frame.pivot][frame.cursor];
+            frame.cursor++;
+            int const location = m_pVertexLookup[next];
+            if (location >= frame.beginP && location < frame.beginR) {
+                vertex = next;
+            }
+        }
+
+        if (vertex < 0) {
+            m_vFrames.pop_back();
+            if (!m_vFrames.empty()) popVertexComplement(partialClique);
+            continue;
+        }
+
+        #ifdef PRINT_CLIQUES_TOMITA_STYLE
+        printf("%d ", vertex);
+        #endif
+
+        // add vertex into partialClique, representing R.
+        partialClique.push_back(vertex);
+
+        // new P and X are P and X without vertex and its neighbors: swap
+        // them to the end of P and to the start of X
+        int newBeginX = frame.beginX;
+        int newBeginR = frame.beginR;
+
+        newBeginR--;
+        SwapVertices(vertex, m_pVertexSets[newBeginR]);
+
+        for (int k = 0; k < m_Degree[vertex]; k++) {
+            int const neighbor = m_AdjacencyList[vertex][k];
+            int const location = m_pVertexLookup[neighbor];
+            if (location >= frame.beginP && location < newBeginR) {
+                newBeginR--;
+                SwapVertices(neighbor, m_pVertexSets[newBeginR]);
+            } else if (location >= newBeginX && location < frame.beginP) {
+                SwapVertices(neighbor, m_pVertexSets[newBeginX]);
+                m_vMovedFrom.push_back(location);
+                newBeginX++;
+            }
+        }
+        frame.childBeginX = newBeginX;
+
+        // descend into the search node with new sets R, P and X;
+        // frame may be invalidated by the push.
+        if (!pushFrameComplement(&cliqueCount, newBeginX, frame.beginP, newBeginR, partialClique, pStatistics)) {
+            popVertexComplement(partialClique);
+        }
+    }
+
+    if (pStatistics) MergeStatistics(statistics);
+
+    Free(m_pVertexSets);
+    Free(m_pVertexLookup);
+    m_pVertexSets   = nullptr;
+    m_pVertexLookup = nullptr;
+
+    return cliqueCount;
+}
+
+/*! \brief Swap the indices of two vertices in vertexSets.
+*/
+
+void ComplementAlgorithm::SwapVertices(int const vertex1, int const vertex2)
+{
+    int const location1 = m_pVertexLookup[vertex1];
+    int const location2 = m_pVertexLookup[vertex2];
+
+    m_pVertexSets[location1] = vertex2;
+    m_pVertexSets[location2] = vertex1;
+    m_pVertexLookup[vertex1] = location2;
+    m_pVertexLookup[vertex2] = location1;
+}
+
+/*! \brief Choose the pivot of a search node, and push a frame for it onto
+           the stack, unless the node is a leaf, which is reported if its
+           partial clique is maximal.
+
+    \param cliqueCount A pointer to the number of maximal cliques computed
+                       thus far.
+
+    \param beginX The index where set X begins in vertexSets.
+
+    \param beginP The index where set P begins in vertexSets.
+
+    \param beginR The index where set P ends in vertexSets.
+
+    \param partialClique A linked list storing R, the partial clique of the node.
+
+    \param pStatistics If non-null, delay statistics for this run are recorded here.
+
+    \return true if a frame was pushed.
+*/
+
+bool ComplementAlgorithm::pushFrameComplement(long* cliqueCount, int beginX, int beginP, int beginR,
+                                              list<int> &partialClique, EnumerationStatistics* pStatistics)
+{
+    if (pStatistics) pStatistics->RecordNode(partialClique.size());
+
+    // if X is empty and P is empty, process partial clique as maximal
+    if (beginX >= beginP && beginP >= beginR) {
+        (*cliqueCount)++;
+
+        if (pStatistics) pStatistics->RecordClique(partialClique.size());
+
+        ExecuteCallBacks(partialClique);
+        processClique(partialClique);
+
+        return false;
+    }
+
+    // avoid work if P is empty.
+    if (beginP >= beginR)
+        return false;
+
+    // find the vertex in P union X with the most complement neighbors in P,
+    // i.e., the fewest neighbors in P (counting itself, if it is in P).
+    int pivot = -1;
+    int minNonNeighborsInP = beginR - beginP + 1;
+    for (int i = beginX; i < beginR && minNonNeighborsInP > 0; i++) {
+        int const vertex = m_pVertexSets[i];
+
+        int numNonNeighborsInP = (i >= beginP) ? 1 : 0;
+        int k = 0;
+        while (k < m_Degree[vertex] && numNonNeighborsInP < minNonNeighborsInP) {
+            int const location = m_pVertexLookup[m_AdjacencyList[vertex][k]];
+            numNonNeighborsInP += (location >= beginP && location < beginR) ? 1 : 0;
+            k++;
+        }
+
+        if (numNonNeighborsInP < minNonNeighborsInP) {
+            pivot = vertex;
+            minNonNeighborsInP = numNonNeighborsInP;
+        }
+    }
+
+    Frame frame;
+    frame.beginX = beginX;
+    frame.beginP = beginP;
+    frame.beginR = beginR;
+    frame.pivot  = pivot;
+    frame.cursor = -1;
+    frame.childBeginX = beginX;
+
+    m_vFrames.push_back(frame);
+    return true;
+}
+
+/*! \brief The search node of the last vertex added to R is done: restore
+           X of the frame on top of the stack, remove that vertex from R,
+           and move it from P to X of the frame.
+*/
+
+void ComplementAlgorithm::popVertexComplement(list<int> &partialClique)
+{
+    #ifdef PRINT_CLIQUES_TOMITA_STYLE
+    printf("b ");
+    #endif
+
+    int const vertex = partialClique.back();
+    partialClique.pop_back();
+
+    Frame &parent(m_vFrames.back());
+
+    // undo the swaps of the vertices of X the child left out, latest first
+    for (int location = parent.childBeginX - 1; location >= parent.beginX; location--) {
+        SwapVertices(m_pVertexSets[location], m_pVertexSets[m_vMovedFrom.back()]);
+        m_vMovedFrom.pop_back();
+    }
+
+    SwapVertices(vertex, m_pVertexSets[parent.beginP]);
+    parent.beginP++;
+}
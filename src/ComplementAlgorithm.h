@@ -0,0 +1,68 @@
+#ifndef _DJS_COMPLEMENT_ALGORITHM_H_
+#define _DJS_COMPLEMENT_ALGORITHM_H_
+
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "AdjacencyListAlgorithm.h"
+
+// system includes
+#include <list>
+#include <vector>
+
+/*! \file ComplementAlgorithm.h
+
+    \brief see ComplementAlgorithm.cpp
+*/
+
+class ComplementAlgorithm : public AdjacencyListAlgorithm
+{
+public:
+    ComplementAlgorithm(std::vector<std::list<int>> &&adjacencyList);
+    virtual ~ComplementAlgorithm();
+
+    virtual long Run(std::list<std::list<int>> &cliques);
+
+    ComplementAlgorithm           (ComplementAlgorithm const &) = delete;
+    ComplementAlgorithm& operator=(ComplementAlgorithm const &) = delete;
+
+    long listAllMaximalCliquesComplement();
+
+    /*! \brief a search node on the explicit stack of the enumeration
+    */
+    struct Frame
+    {
+        int beginX;      //!< the index where set X begins in vertexSets
+        int beginP;      //!< the index where set P begins in vertexSets
+        int beginR;      //!< the index where set P ends in vertexSets
+        int pivot;       //!< the candidates are the vertices of P among pivot and its neighbors
+        int cursor;      //!< the next candidate: -1 for the pivot, k for its k-th neighbor
+        int childBeginX; //!< the index where X of the current child begins in vertexSets
+    };
+
+private:
+    bool pushFrameComplement(long* cliqueCount, int beginX, int beginP, int beginR,
+                             std::list<int> &partialClique, EnumerationStatistics* pStatistics);
+    void popVertexComplement(std::list<int> &partialClique);
+    void SwapVertices(int vertex1, int vertex2);
+
+    int* m_pVertexSets;          //!< X, then P, then the vertices in neither
+    int* m_pVertexLookup;        //!< the index of each vertex in m_pVertexSets
+    std::vector<Frame> m_vFrames; //!< the explicit stack
+    std::vector<int> m_vMovedFrom; //!< the indices the vertices of X moved from, for each child on the stack
+};
+
+#endif
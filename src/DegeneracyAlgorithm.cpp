@@ -25,6 +25,7 @@
 #include <vector>
 #include "MemoryManager.h"
 #include "DegeneracyTools.h"
+#include "RootCostModel.h"
 
 #include "DegeneracyAlgorithm.h"
 
@@ -96,17 +97,107 @@ using namespace std;
 
 DegeneracyAlgorithm::DegeneracyAlgorithm(vector<list<int>> const &adjacencyList)
  : Algorithm("degeneracy")
- , m_AdjacencyList(adjacencyList)
+ , m_iNumVertices(adjacencyList.size())
+ , m_pOrderingArray(computeDegeneracyOrderArray(adjacencyList, adjacencyList.size()))
+ , m_pVertexSets(nullptr)
+ , m_pVertexLookup(nullptr)
+ , m_ppNeighborsInP(nullptr)
+ , m_pNumNeighbors(nullptr)
+ , m_iBeginX(0)
+ , m_iBeginP(0)
+ , m_iBeginR(0)
+ , m_iBeginRoot(0)
+ , m_iEndRoot(m_iNumVertices)
+ , m_iNextRoot(0)
+ , m_lCliqueCount(0)
+ , m_SizeThreshold(0)
+ , m_vPartialClique()
+ , m_vFrames()
+ , m_bChildPending(false)
+ , m_bStarted(false)
+ , m_bStopped(false)
+ , m_RunStatistics()
+ , m_pRunStatistics(nullptr)
 {
 }
 
-DegeneracyAlgorithm::~DegeneracyAlgorithm()
+/*! \brief Construct the algorithm from a graph it may consume. The
+           degeneracy order is the only representation of the graph
+           that the algorithm reads, so the adjacency list is released
+           while the ordering is built.
+*/
+
+DegeneracyAlgorithm::DegeneracyAlgorithm(vector<list<int>> &&adjacencyList)
+ : Algorithm("degeneracy")
+ , m_iNumVertices(adjacencyList.size())
+ , m_pOrderingArray(computeDegeneracyOrderArray(std::move(adjacencyList), m_iNumVertices))
+ , m_pVertexSets(nullptr)
+ , m_pVertexLookup(nullptr)
+ , m_ppNeighborsInP(nullptr)
+ , m_pNumNeighbors(nullptr)
+ , m_iBeginX(0)
+ , m_iBeginP(0)
+ , m_iBeginR(0)
+ , m_iBeginRoot(0)
+ , m_iEndRoot(m_iNumVertices)
+ , m_iNextRoot(0)
+ , m_lCliqueCount(0)
+ , m_SizeThreshold(0)
+ , m_vPartialClique()
+ , m_vFrames()
+ , m_bChildPending(false)
+ , m_bStarted(false)
+ , m_bStopped(false)
+ , m_RunStatistics()
+ , m_pRunStatistics(nullptr)
 {
 }
 
-long DegeneracyAlgorithm::Run(list<list<int>> &cliques)
+/*! \brief Construct the algorithm from a degeneracy order that was
+           already computed (e.g., by GraphStatistics), and take ownership
+           of it.
+
+    \param orderingArray the degeneracy order, as computed by
+                         computeDegeneracyOrderArray, indexed by vertex.
+
+    \param numVertices the number of vertices in the graph.
+*/
+
+DegeneracyAlgorithm::DegeneracyAlgorithm(NeighborListArray **orderingArray, int const numVertices)
+ : Algorithm("degeneracy")
+ , m_iNumVertices(numVertices)
+ , m_pOrderingArray(orderingArray)
+ , m_pVertexSets(nullptr)
+ , m_pVertexLookup(nullptr)
+ , m_ppNeighborsInP(nullptr)
+ , m_pNumNeighbors(nullptr)
+ , m_iBeginX(0)
+ , m_iBeginP(0)
+ , m_iBeginR(0)
+ , m_iBeginRoot(0)
+ , m_iEndRoot(m_iNumVertices)
+ , m_iNextRoot(0)
+ , m_lCliqueCount(0)
+ , m_SizeThreshold(0)
+ , m_vPartialClique()
+ , m_vFrames()
+ , m_bChildPending(false)
+ , m_bStarted(false)
+ , m_bStopped(false)
+ , m_RunStatistics()
+ , m_pRunStatistics(nullptr)
 {
-    return listAllMaximalCliquesDegeneracy(m_AdjacencyList, m_AdjacencyList.size());
+}
+
+DegeneracyAlgorithm::~DegeneracyAlgorithm()
+{
+    FinishEnumeration();
+
+    for (int i = 0; i < m_iNumVertices; i++) {
+        delete m_pOrderingArray[i];
+    }
+
+    Free(m_pOrderingArray);
 }
 
 
@@ -405,126 +496,174 @@ inline void fillInPandXForRecursiveCallDegeneracy( int vertex, int orderNumber,
 ////    timeFillInPX += (endClock - startClock);
 }
 
-/*! \brief List all maximal cliques in a given graph using the algorithm
-           by Eppstein et al. (ISAAC 2010/SEA 2011).
-
-    \param adjList An array of linked lists, representing the input graph in the
-                   "typical" adjacency list format.
- 
-    \param degree An array, indexed by vertex, containing the degree of that vertex. (not currently used)
-
-    \param size The number of vertices in the graph.
-
-    \return the number of maximal cliques of the input graph.
+/*! \brief Allocate the sets and arrays of neighbors in P used by the
+           enumeration, and position it before the first root.
 */
 
-static unsigned long largestDifference(0);
-static unsigned long numLargeJumps;
-static unsigned long stepsSinceLastReportedClique(0);
-
-long DegeneracyAlgorithm::listAllMaximalCliquesDegeneracy(vector<list<int>> const &adjList, int size)
+void DegeneracyAlgorithm::StartEnumeration()
 {
+    int const size(m_iNumVertices);
+
     // vertex sets are stored in an array like this:
     // |--X--|--P--|
-    int* vertexSets = (int*)Calloc(size, sizeof(int));
+    m_pVertexSets = (int*)Calloc(size, sizeof(int));
 
     // vertex i is stored in vertexSets[vertexLookup[i]]
-    int* vertexLookup = (int*)Calloc(size, sizeof(int));
+    m_pVertexLookup = (int*)Calloc(size, sizeof(int));
 
-    int** neighborsInP = (int**)Calloc(size, sizeof(int*));
-    int* numNeighbors = (int*)Calloc(size, sizeof(int));
-    
-    // compute the degeneracy order
-////    clock_t clockStart = clock();
-    NeighborListArray** orderingArray = computeDegeneracyOrderArray(adjList, size);
-////    clock_t clockEnd = clock();
-////    clock_t timeDegeneracyOrder = clockEnd - clockStart;
+    m_ppNeighborsInP = (int**)Calloc(size, sizeof(int*));
+    m_pNumNeighbors = (int*)Calloc(size, sizeof(int));
 
     int i = 0;
 
     while(i<size)
     {
-        vertexLookup[i] = i;
-        vertexSets[i] = i;
-        neighborsInP[i] = (int*)Calloc(1, sizeof(int));
-        numNeighbors[i] = 1;
+        m_pVertexLookup[i] = i;
+        m_pVertexSets[i] = i;
+        m_ppNeighborsInP[i] = (int*)Calloc(1, sizeof(int));
+        m_pNumNeighbors[i] = 1;
         i++;
     }
 
-    int beginX = 0;
-    int beginP = 0;
-    int beginR = size;
+    m_iBeginX = 0;
+    m_iBeginP = 0;
+    m_iBeginR = size;
+    m_iNextRoot = m_iBeginRoot;
+    m_lCliqueCount = 0;
+    m_vPartialClique.clear();
+    m_vFrames.clear();
+    m_bChildPending = false;
+    m_bStarted = true;
+    m_bStopped = false;
+
+    // statistics are gathered locally, and published when the run completes
+    m_RunStatistics.Clear();
+    m_pRunStatistics = GetCollectStatistics() ? &m_RunStatistics : nullptr;
+    ClearStatistics();
+    if (m_pRunStatistics) m_pRunStatistics->Start();
+}
 
-    long cliqueCount = 0;
+/*! \brief Release the working memory of the enumeration, and publish its
+           statistics. Called when the enumeration completes or is stopped.
+*/
 
-    list<int> partialClique;
+void DegeneracyAlgorithm::FinishEnumeration()
+{
+    if (!m_bStarted || m_bStopped) return;
 
-    // for each vertex
-    for(i=0;i<size;i++)
+    for (Frame &frame : m_vFrames) {
+        Free(frame.candidates);
+    }
+    m_vFrames.clear();
+    m_vPartialClique.clear();
+
+    if (m_pRunStatistics) {
+        m_pRunStatistics->FinishRoot();
+        MergeStatistics(m_RunStatistics);
+    }
+
+    Free(m_pVertexSets);
+    Free(m_pVertexLookup);
+
+    for(int i = 0; i<m_iNumVertices; i++)
     {
-        int vertex = (int)orderingArray[i]->vertex;
+        Free(m_ppNeighborsInP[i]);
+    }
+
+    Free(m_ppNeighborsInP);
+    Free(m_pNumNeighbors);
+
+    m_pVertexSets = nullptr;
+    m_pVertexLookup = nullptr;
+    m_ppNeighborsInP = nullptr;
+    m_pNumNeighbors = nullptr;
+
+    m_bStopped = true;
+}
 
-        #ifdef PRINT_CLIQUES_TOMITA_STYLE
-        printf("%d ", vertex);
-        #endif
+void DegeneracyAlgorithm::Stop()
+{
+    FinishEnumeration();
+}
 
-        // add vertex to partial clique R
-        partialClique.push_back(vertex);
+long DegeneracyAlgorithm::GetCliqueCount() const
+{
+    return m_lCliqueCount;
+}
 
-        int newBeginX, newBeginP, newBeginR;
+int DegeneracyAlgorithm::GetCurrentRoot() const
+{
+    return m_iNextRoot - 1;
+}
 
-        // set P to be later neighbors and X to be be earlier neighbors
-        // of vertex
-        fillInPandXForRecursiveCallDegeneracy( i, vertex, 
-                                               vertexSets, vertexLookup, 
-                                               orderingArray,
-                                               neighborsInP, numNeighbors,
-                                               &beginX, &beginP, &beginR, 
-                                               &newBeginX, &newBeginP, &newBeginR);
+/*! \brief Start the enumeration over at a root, skipping all earlier roots.
 
-        // recursively compute maximal cliques containing vertex, some of its
-        // later neighbors, and avoiding earlier neighbors
-        listAllMaximalCliquesDegeneracyRecursive(&cliqueCount,
-                                                  partialClique, 
-                                                  vertexSets, vertexLookup,
-                                                  neighborsInP, numNeighbors,
-                                                  newBeginX, newBeginP, newBeginR); 
+    Roots are vertex ids, and are visited in increasing order of vertex
+    id; the degeneracy order only splits the neighbors of each root into
+    P (later) and X (earlier). Each root fills in its own sets P and X, so
+    the search trees of the remaining roots do not depend on the roots
+    that were skipped.
 
-        #ifdef PRINT_CLIQUES_TOMITA_STYLE
-        printf("b ");
-        #endif
+    \param nextRoot the vertex id of the first root to search.
 
-        beginR = beginR + 1;
+    \param cliqueCount the number of cliques of the skipped roots.
+*/
 
-        partialClique.pop_back();
-    }
+void DegeneracyAlgorithm::Resume(int const nextRoot, long const cliqueCount)
+{
+    FinishEnumeration();
+    StartEnumeration();
+    m_iNextRoot = nextRoot;
+    m_lCliqueCount = cliqueCount;
+}
 
-    //cerr << endl;
-    //cerr << "Largest Difference  : " << largestDifference << endl;
-    //cerr << "Num     Differences : " << numLargeJumps << endl;
-    //cerr << "Time Computing Pivot: " << ((double)(timeComputingPivot)/(double)(CLOCKS_PER_SEC)) << endl;
-    //cerr << "Time Moving R to X  : " << ((double)(timeMovingFromRtoX)/(double)(CLOCKS_PER_SEC)) << endl;
-    //cerr << "Time Moving   to R  : " << ((double)(timeMovingToR)/(double)(CLOCKS_PER_SEC)) << endl;
-    //cerr << "Time Moving X to P  : " << ((double)(timeMovingXToP)/(double)(CLOCKS_PER_SEC)) << endl;
-    //cerr << "Time Making X and P : " << ((double)(timeFillInPX)/(double)(CLOCKS_PER_SEC)) << endl;
-    //cerr << "Time Degeneracy Ordr: " << ((double)(timeDegeneracyOrder)/(double)(CLOCKS_PER_SEC)) << endl;
+int DegeneracyAlgorithm::GetNumRoots() const
+{
+    return m_iNumVertices;
+}
 
-    partialClique.clear();
+/*! \brief Restrict the enumeration to a range of roots, which takes effect
+           when the enumeration (re)starts.
 
-    Free(vertexSets);
-    Free(vertexLookup);
+    Roots are vertex ids, so a range is a range of vertex ids, not of
+    positions in the degeneracy order. The search trees of different roots
+    are disjoint, so the cliques of several ranges that partition
+    [0, GetNumRoots()) are exactly the maximal cliques of the graph.
 
-    for(i = 0; i<size; i++)
-    {
-        Free(neighborsInP[i]);
-        delete orderingArray[i];
-    }
+    \param beginRoot the vertex id of the first root.
+
+    \param endRoot one past the vertex id of the last root.
+*/
+
+void DegeneracyAlgorithm::SetRootRange(int const beginRoot, int const endRoot)
+{
+    m_iBeginRoot = max(0, min(beginRoot, m_iNumVertices));
+    m_iEndRoot   = max(m_iBeginRoot, min(endRoot, m_iNumVertices));
+}
+
+/*! \brief Predict the work of each root, see RootCostModel.
 
-    Free(orderingArray);
-    Free(neighborsInP);
-    Free(numNeighbors);
+    \return the predicted cost of each root.
+*/
 
-    return cliqueCount;
+vector<double> DegeneracyAlgorithm::EstimateRootCosts() const
+{
+    return RootCostModel(m_pOrderingArray, m_iNumVertices).Estimate();
+}
+
+/*! \brief Skip the cliques of at most threshold vertices from now on.
+
+    A search node whose sets R and P have at most threshold vertices
+    together is not searched, and neither is a root with at most
+    threshold - 1 later neighbors. The threshold takes effect at the next
+    search node, so it may be raised while the enumeration is suspended.
+
+    \param threshold the size of the largest cliques that may be skipped.
+*/
+
+void DegeneracyAlgorithm::SetSizeThreshold(size_t const threshold)
+{
+    m_SizeThreshold = threshold;
 }
 
 /*! \brief Move a vertex to the set R, and update sets P and X
@@ -709,26 +848,8 @@ inline void moveFromRToXDegeneracy( int vertex,
 ////    timeMovingFromRtoX += (clockEnd - clockStart);
 }
 
-/*! \brief Recursively list all maximal cliques containing all of
-           all vertices in R, some vertices in P and no vertices in X.
-
-    \param cliqueCount A pointer to the number of maximal cliques computed 
-                       thus far.
-
-    \param partialClique A linked list storing R, the partial clique for this
-                         recursive call. 
-
-    \param vertexSets An array containing sets of vertices divided into sets X, P, R and other.
- 
-    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
-                        vertex in vertexSets.
-
-    \param neighborsInP Maps vertices to arrays of neighbors such that 
-                        neighbors in P fill the first cells
-
-    \param numNeighbors An the neighbor of neighbors a vertex had in P,
-                        the first time this function is called, this bound is 
-                        used to keep us from allocating more than linear space.
+/*! \brief Compute the candidates of a search node, and push a frame for it
+           onto the stack, unless the node is a leaf.
 
     \param beginX The index where set X begins in vertexSets.
  
@@ -736,122 +857,234 @@ inline void moveFromRToXDegeneracy( int vertex,
 
     \param beginR The index where set R begins in vertexSets.
 
+    \return NODE_PUSHED if a frame was pushed, NODE_CLIQUE if the node is a
+            leaf whose partial clique is maximal, and NODE_LEAF otherwise.
 */
 
-void DegeneracyAlgorithm::listAllMaximalCliquesDegeneracyRecursive(long* cliqueCount,
-                                               list<int> &partialClique, 
-                                               int* vertexSets, int* vertexLookup,
-                                               int** neighborsInP, int* numNeighbors,
-                                               int beginX, int beginP, int beginR)
+DegeneracyAlgorithm::NodeType DegeneracyAlgorithm::pushFrameDegeneracy(int beginX, int beginP, int beginR)
 {
+    if (m_pRunStatistics) m_pRunStatistics->RecordNode(m_vPartialClique.size());
 
-    stepsSinceLastReportedClique++;
+    // every clique below this node is contained in R union P
+    if (m_vPartialClique.size() + (beginR - beginP) <= m_SizeThreshold)
+        return NODE_LEAF;
 
-    // if X is empty and P is empty, process partial clique as maximal
+    // if X is empty and P is empty, the partial clique is maximal
     if(beginX >= beginP && beginP >= beginR)
     {
-        (*cliqueCount)++;
+        m_lCliqueCount++;
 
-        if (stepsSinceLastReportedClique > partialClique.size()) {
-            numLargeJumps++;
-            //cerr << "steps: " << stepsSinceLastReportedClique << ">" << partialClique.size() << endl;
-            if (largestDifference < (stepsSinceLastReportedClique - partialClique.size())) {
-                largestDifference = stepsSinceLastReportedClique - partialClique.size();
-            }
-        }
-
-        stepsSinceLastReportedClique = 0;
+        if (m_pRunStatistics) m_pRunStatistics->RecordClique(m_vPartialClique.size());
 
-        ExecuteCallBacks(partialClique);
-        processClique(partialClique);
-
-        return;
+        return NODE_CLIQUE;
     }
 
     // avoid work if P is empty.
     if(beginP >= beginR)
-        return;
+        return NODE_LEAF;
 
-    int* myCandidatesToIterateThrough;
-    int numCandidatesToIterateThrough;
+    Frame frame;
+    frame.beginX = beginX;
+    frame.beginP = beginP;
+    frame.beginR = beginR;
+    frame.cursor = 0;
 
     // get the candidates to add to R to make a maximal clique
-    findBestPivotNonNeighborsDegeneracy( &myCandidatesToIterateThrough,
-                                         &numCandidatesToIterateThrough,
-                                         vertexSets, vertexLookup,
-                                         neighborsInP, numNeighbors,
+    findBestPivotNonNeighborsDegeneracy( &frame.candidates,
+                                         &frame.numCandidates,
+                                         m_pVertexSets, m_pVertexLookup,
+                                         m_ppNeighborsInP, m_pNumNeighbors,
                                          beginX, beginP, beginR);
 
-    // add candiate vertices to the partial clique one at a time and 
-    // search for maximal cliques
-    if(numCandidatesToIterateThrough != 0)
-    {
-    int iterator = 0;
-    while(iterator < numCandidatesToIterateThrough)
-    {
-        // vertex to be added to the partial clique
-        int vertex = myCandidatesToIterateThrough[iterator];
+    m_vFrames.push_back(frame);
+    return NODE_PUSHED;
+}
+
+/*! \brief The search node of the last vertex added to R is done: remove
+           that vertex from R. Below the root, it moves to X of the frame
+           on top of the stack; a root returns to the rest of the graph.
+*/
+
+void DegeneracyAlgorithm::popVertexDegeneracy()
+{
+    #ifdef PRINT_CLIQUES_TOMITA_STYLE
+    printf("b ");
+    #endif
 
-        #ifdef PRINT_CLIQUES_TOMITA_STYLE
-        printf("%d ", vertex);
-        #endif
+    int const vertex = m_vPartialClique.back();
+    m_vPartialClique.pop_back();
 
-        int newBeginX, newBeginP, newBeginR;
+    if (m_vFrames.empty()) {
+        m_iBeginR = m_iBeginR + 1;
+        return;
+    }
 
-        // add vertex into partialClique, representing R.
-        partialClique.push_back(vertex);
+    Frame &parent(m_vFrames.back());
+    moveFromRToXDegeneracy( vertex, 
+                            m_pVertexSets, m_pVertexLookup,
+                            &parent.beginX, &parent.beginP, &parent.beginR );
+}
 
-        // swap vertex into R and update all data structures 
-        moveToRDegeneracy( vertex, 
-                           vertexSets, vertexLookup, 
-                           neighborsInP, numNeighbors,
-                           &beginX, &beginP, &beginR, 
-                           &newBeginX, &newBeginP, &newBeginR);
+/*! \brief Continue the enumeration up to the next maximal clique.
 
-        // recursively compute maximal cliques with new sets R, P and X
-        listAllMaximalCliquesDegeneracyRecursive(cliqueCount,
-                                                 partialClique, 
-                                                 vertexSets, vertexLookup,
-                                                 neighborsInP, numNeighbors,
-                                                 newBeginX, newBeginP, newBeginR);
+    This is the algorithm of Eppstein et al., run with an explicit stack
+    of frames instead of native recursion: each frame holds the boundaries
+    of X, P and R of a search node, its candidates (P minus the neighbors
+    of the pivot), and a cursor to the next candidate to add to R. Between
+    calls, the whole state of the search is in members of this object, so
+    the enumeration is suspended at each maximal clique, and its depth is
+    bounded by memory rather than by the call stack.
 
-        #ifdef PRINT_CLIQUES_TOMITA_STYLE
-        printf("b ");
-        #endif
+    \param clique On return, the vertices of the next maximal clique.
 
-        // remove vertex from partialClique
-        partialClique.pop_back();
+    \return true if a clique was found, false if the enumeration is complete
+            or was stopped.
+*/
 
-        moveFromRToXDegeneracy( vertex, 
-                                vertexSets, vertexLookup,
-                                &beginX, &beginP, &beginR );
+bool DegeneracyAlgorithm::Next(CliqueSpan &clique)
+{
+    if (!m_bStarted) StartEnumeration();
+    if (m_bStopped) return false;
 
-        iterator++;
+    // finish the search node of the clique returned by the previous call
+    if (m_bChildPending) {
+        m_bChildPending = false;
+        popVertexDegeneracy();
     }
 
-    // swap vertices that were moved to X back into P, for higher recursive calls.
-    iterator = 0;
-
-////    clock_t clockStart = clock();
-    while(iterator < numCandidatesToIterateThrough)
+    while (true)
     {
-        int vertex = myCandidatesToIterateThrough[iterator];
-        int vertexLocation = vertexLookup[vertex];
+        NodeType nodeType(NODE_LEAF);
+
+        if (m_vFrames.empty())
+        {
+            // the largest clique of a root has its later neighbors, at most
+            while (m_iNextRoot < m_iEndRoot &&
+                   static_cast<size_t>(m_pOrderingArray[m_iNextRoot]->laterDegree) + 1 <= m_SizeThreshold) {
+                m_iNextRoot++;
+            }
+
+            if (m_iNextRoot >= m_iEndRoot) {
+                FinishEnumeration();
+                return false;
+            }
+
+            // the next root: R = {vertex}, P = its later neighbors, and
+            // X = its earlier neighbors
+            int i = m_iNextRoot++;
+            int vertex = (int)m_pOrderingArray[i]->vertex;
+
+            if (m_pRunStatistics) m_pRunStatistics->StartRoot(i);
+
+            #ifdef PRINT_CLIQUES_TOMITA_STYLE
+            printf("%d ", vertex);
+            #endif
+
+            m_vPartialClique.push_back(vertex);
+
+            int newBeginX, newBeginP, newBeginR;
 
-        beginP--;
-        vertexSets[vertexLocation] = vertexSets[beginP];
-        vertexSets[beginP] = vertex;
-        vertexLookup[vertex] = beginP;
-        vertexLookup[vertexSets[vertexLocation]] = vertexLocation;
+            fillInPandXForRecursiveCallDegeneracy( i, vertex, 
+                                                   m_pVertexSets, m_pVertexLookup, 
+                                                   m_pOrderingArray,
+                                                   m_ppNeighborsInP, m_pNumNeighbors,
+                                                   &m_iBeginX, &m_iBeginP, &m_iBeginR, 
+                                                   &newBeginX, &newBeginP, &newBeginR);
 
-        iterator++;
+            nodeType = pushFrameDegeneracy(newBeginX, newBeginP, newBeginR);
+        }
+        else
+        {
+            Frame &frame(m_vFrames.back());
+
+            // candidates already searched have moved to X, so the bound
+            // on the remaining cliques of the node shrinks
+            bool const bPruned(m_vPartialClique.size() + (frame.beginR - frame.beginP) <= m_SizeThreshold);
+
+            if (frame.cursor < frame.numCandidates && !bPruned)
+            {
+                // vertex to be added to the partial clique
+                int vertex = frame.candidates[frame.cursor];
+                frame.cursor++;
+
+                #ifdef PRINT_CLIQUES_TOMITA_STYLE
+                printf("%d ", vertex);
+                #endif
+
+                int newBeginX, newBeginP, newBeginR;
+
+                // add vertex into partialClique, representing R.
+                m_vPartialClique.push_back(vertex);
+
+                // swap vertex into R and update all data structures 
+                moveToRDegeneracy( vertex, 
+                                   m_pVertexSets, m_pVertexLookup, 
+                                   m_ppNeighborsInP, m_pNumNeighbors,
+                                   &frame.beginX, &frame.beginP, &frame.beginR, 
+                                   &newBeginX, &newBeginP, &newBeginR);
+
+                // descend into the search node with new sets R, P and X;
+                // frame may be invalidated by the push.
+                nodeType = pushFrameDegeneracy(newBeginX, newBeginP, newBeginR);
+            }
+            else
+            {
+                // swap vertices that were moved to X back into P, for higher search nodes;
+                // a pruned node moved only the candidates before the cursor.
+                int iterator = 0;
+                while(iterator < frame.cursor)
+                {
+                    int vertex = frame.candidates[iterator];
+                    int vertexLocation = m_pVertexLookup[vertex];
+
+                    frame.beginP--;
+                    m_pVertexSets[vertexLocation] = m_pVertexSets[frame.beginP];
+                    m_pVertexSets[frame.beginP] = vertex;
+                    m_pVertexLookup[vertex] = frame.beginP;
+                    m_pVertexLookup[m_pVertexSets[vertexLocation]] = vertexLocation;
+
+                    iterator++;
+                }
+
+                // don't need to check for emptiness before freeing, since
+                // something will always be there (we allocated enough memory
+                // for all of P, which is nonempty)
+                Free(frame.candidates);
+                m_vFrames.pop_back();
+            }
+        }
+
+        if (nodeType == NODE_PUSHED) continue;
+
+        if (nodeType == NODE_CLIQUE) {
+            // the node is finished on the next call, once the consumer is
+            // done with the clique
+            m_bChildPending = true;
+            clique = CliqueSpan(m_vPartialClique.data(), m_vPartialClique.size());
+            return true;
+        }
+
+        popVertexDegeneracy();
     }
-////    clock_t clockEnd = clock();
-////    timeMovingXToP += (clockEnd - clockStart);
+}
+
+/*! \brief List all maximal cliques, passing each to the callbacks.
+
+    \return the number of maximal cliques of the input graph.
+*/
+
+long DegeneracyAlgorithm::Run(list<list<int>> &cliques)
+{
+    // start over, even if a previous enumeration was not completed
+    FinishEnumeration();
+    StartEnumeration();
+
+    CliqueSpan clique;
+    while (Next(clique)) {
+        list<int> const partialClique(clique.begin(), clique.end());
+        ExecuteCallBacks(partialClique);
+        processClique(partialClique);
     }
 
-    // don't need to check for emptiness before freeing, since
-    // something will always be there (we allocated enough memory
-    // for all of P, which is nonempty)
-    Free(myCandidatesToIterateThrough);
-}
\ No newline at end of file
+    return m_lCliqueCount;
+}
@@ -21,6 +21,7 @@
 #include "Tools.h"
 #include "MemoryManager.h"
 #include "DegeneracyTools.h"
+#include "CliqueGenerator.h"
 
 // system includes
 #include <list>
@@ -47,27 +48,78 @@
     \endhtmlonly
 */
 
-class DegeneracyAlgorithm : public Algorithm
+class DegeneracyAlgorithm : public Algorithm, public CliqueGenerator
 {
 public:
     DegeneracyAlgorithm(std::vector<std::list<int>> const &adjacencyList);
+    DegeneracyAlgorithm(std::vector<std::list<int>> &&adjacencyList);
+    DegeneracyAlgorithm(NeighborListArray **orderingArray, int numVertices);
     virtual ~DegeneracyAlgorithm();
 
     virtual long Run(std::list<std::list<int>> &cliques);
 
+    virtual bool Next(CliqueSpan &clique);
+    virtual void Stop();
+    virtual long GetCliqueCount() const;
+    virtual int  GetCurrentRoot() const;
+    virtual void Resume(int nextRoot, long cliqueCount);
+    virtual int  GetNumRoots() const;
+    virtual void SetRootRange(int beginRoot, int endRoot);
+    virtual std::vector<double> EstimateRootCosts() const;
+    virtual void SetSizeThreshold(size_t threshold);
+
     DegeneracyAlgorithm           (DegeneracyAlgorithm const &) = delete;
     DegeneracyAlgorithm& operator=(DegeneracyAlgorithm const &) = delete;
 
-    void listAllMaximalCliquesDegeneracyRecursive(long* cliqueCount,
-                                               std::list<int> &partialClique, 
-                                               int* vertexSets, int* vertexLookup,
-                                               int** neighborsInP, int* numNeighbors,
-                                               int beginX, int beginP, int beginR);
-
-    long listAllMaximalCliquesDegeneracy(std::vector<std::list<int>> const &adjList, int size);
+    /*! \brief a search node on the explicit stack of the enumeration
+    */
+    struct Frame
+    {
+        int beginX;        //!< the index where set X begins in vertexSets
+        int beginP;        //!< the index where set P begins in vertexSets
+        int beginR;        //!< the index where set R begins in vertexSets
+        int* candidates;   //!< P minus the neighbors of the pivot
+        int numCandidates; //!< the number of entries in candidates
+        int cursor;        //!< the index of the next candidate to add to R
+    };
 
 private:
-    std::vector<std::list<int>> const &m_AdjacencyList;
+    enum NodeType
+    {
+        NODE_PUSHED, //!< a frame was pushed for the node
+        NODE_CLIQUE, //!< the node is a maximal clique
+        NODE_LEAF    //!< the node has no candidates, and is not maximal
+    };
+
+    void StartEnumeration();
+    void FinishEnumeration();
+
+    NodeType pushFrameDegeneracy(int beginX, int beginP, int beginR);
+    void popVertexDegeneracy();
+
+    int m_iNumVertices;
+    NeighborListArray** m_pOrderingArray;
+
+    // the state of the enumeration, between calls to Next
+    int* m_pVertexSets;
+    int* m_pVertexLookup;
+    int** m_ppNeighborsInP;
+    int* m_pNumNeighbors;
+    int m_iBeginX;
+    int m_iBeginP;
+    int m_iBeginR;
+    int m_iBeginRoot;                 //!< the vertex id of the first root
+    int m_iEndRoot;                   //!< one past the vertex id of the last root
+    int m_iNextRoot;                  //!< the vertex id of the next root
+    long m_lCliqueCount;
+    size_t m_SizeThreshold;            //!< cliques of at most this size are skipped
+    std::vector<int> m_vPartialClique; //!< R
+    std::vector<Frame> m_vFrames;      //!< the explicit stack
+    bool m_bChildPending;              //!< the last vertex of R still has to be removed
+    bool m_bStarted;
+    bool m_bStopped;
+    EnumerationStatistics m_RunStatistics;
+    EnumerationStatistics* m_pRunStatistics;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -427,6 +427,116 @@ NeighborListArray** computeDegeneracyOrderArray(vector<list<int>> const &adjList
     return orderingArray;
 }
 
+/*! \brief Compute a degeneracy ordering, taking ownership of the input graph.
+
+    The neighbor list of each vertex is split directly into the
+    earlier and later arrays of its NeighborListArray, and then released,
+    as soon as the vertex is placed in the ordering. The input graph
+    is never stored more than once, and is empty when this function returns.
+
+    \param adjList an input graph, represented as an array of linked lists of integers
+
+    \param size the number of vertices in the graph
+
+    \return an array of NeighborListArrays representing a degeneracy ordering of the vertices.
+
+    \see NeighborListArray
+*/
+
+NeighborListArray** computeDegeneracyOrderArray(vector<list<int>> &&adjList, int size)
+{
+    NeighborListArray** orderingArray = (NeighborListArray**)Calloc(size, sizeof(NeighborListArray*));
+
+    int i = 0;
+
+    // array of lists of vertices, indexed by degree
+    vector<list<int>> verticesByDegree(size);
+
+    // array of lists of vertices, indexed by degree
+    vector<list<int>::iterator> vertexLocator(size);
+
+    vector<int> degree(size);
+
+    for(i=0; i<size; i++)
+    {
+        degree[i] = adjList[i].size();
+        verticesByDegree[degree[i]].push_front(i);
+        vertexLocator[i] = verticesByDegree[degree[i]].begin();
+    }
+
+    int currentDegree = 0;
+
+    int numVerticesRemoved = 0;
+
+    while(numVerticesRemoved < size)
+    {
+        if(!verticesByDegree[currentDegree].empty())
+        {
+            int const vertex = verticesByDegree[currentDegree].front();
+            verticesByDegree[currentDegree].pop_front();
+
+            degree[vertex] = -1;
+
+            list<int> &neighborList = adjList[vertex];
+
+            // count earlier neighbors first, so that both arrays
+            // are allocated exactly once, at their final size.
+            int numEarlier = 0;
+            for(int const neighbor : neighborList)
+            {
+                if(degree[neighbor]==-1) numEarlier++;
+            }
+
+            NeighborListArray* pNeighbors = new NeighborListArray();
+            pNeighbors->vertex = vertex;
+            pNeighbors->orderNumber = numVerticesRemoved;
+            pNeighbors->earlierDegree = numEarlier;
+            pNeighbors->earlier.resize(numEarlier);
+            pNeighbors->laterDegree = neighborList.size() - numEarlier;
+            pNeighbors->later.resize(pNeighbors->laterDegree);
+
+            int numLaterFilled = 0;
+            int numEarlierFilled = 0;
+            for(int const neighbor : neighborList)
+            {
+                if(degree[neighbor]!=-1)
+                {
+                    verticesByDegree[degree[neighbor]].erase(vertexLocator[neighbor]);
+                    pNeighbors->later[numLaterFilled++] = neighbor;
+
+                    degree[neighbor]--;
+
+                    if(degree[neighbor] != -1)
+                    {
+                        verticesByDegree[degree[neighbor]].push_front(neighbor);
+                        vertexLocator[neighbor] = verticesByDegree[degree[neighbor]].begin();
+                    }
+                }
+                else
+                {
+                    pNeighbors->earlier[numEarlierFilled++] = neighbor;
+                }
+            }
+
+            orderingArray[vertex] = pNeighbors;
+
+            // this vertex's neighbors are never read again
+            list<int>().swap(neighborList);
+
+            numVerticesRemoved++;
+            currentDegree = 0;
+        }
+        else
+        {
+            currentDegree++;
+        }
+    }
+
+    vector<list<int>>().swap(adjList);
+
+    return orderingArray;
+}
+
 // there is a problem with this algorithm
 vector<NeighborListArray> computeMaximumLaterOrderArray(vector<vector<int>> &adjArray, int size)
 {
@@ -1054,3 +1164,79 @@ vector<int> GetVerticesInDegeneracyOrder(vector<vector<int>> &adjArray)
 
     return vResult;
 }
+
+/*! \brief Compute a degeneracy ordering of a graph stored in arrays,
+           and split each neighbor array into earlier and later neighbors.
+
+    \param adjArray An array of arrays, the neighbors of each vertex. On return,
+                    the neighbors of each vertex are permuted so that the
+                    earlier neighbors come first, followed by the later ones.
+
+    \param degree An array, indexed by vertex, containing the degree of that vertex.
+
+    \param earlierDegree An array, indexed by vertex, that on return contains
+                         the number of earlier neighbors of that vertex.
+
+    \param size The number of vertices in the graph.
+
+    \return the vertices, in degeneracy order.
+*/
+
+vector<int> GetVerticesInDegeneracyOrder(int** adjArray, int* degree, int* earlierDegree, int size)
+{
+    vector<int> vResult(size, -1);
+
+    // array of lists of vertices, indexed by degree
+    vector<list<int>> verticesByDegree(size);
+
+    // array of lists of vertices, indexed by degree
+    vector<list<int>::iterator> vertexLocator(size);
+
+    vector<int> remainingDegree(size);
+
+    for (int i = 0; i < size; i++) {
+        remainingDegree[i] = degree[i];
+        verticesByDegree[remainingDegree[i]].push_front(i);
+        vertexLocator[i] = verticesByDegree[remainingDegree[i]].begin();
+    }
+
+    int currentDegree = 0;
+    int numVerticesRemoved = 0;
+
+    while (numVerticesRemoved < size) {
+        if (!verticesByDegree[currentDegree].empty()) {
+            int const vertex = verticesByDegree[currentDegree].front();
+            verticesByDegree[currentDegree].pop_front();
+
+            vResult[numVerticesRemoved] = vertex;
+            remainingDegree[vertex] = -1;
+
+            // swap later neighbors to end of neighbor array
+            int* neighborList = adjArray[vertex];
+            int splitPoint(degree[vertex]);
+            for (int i = 0; i < splitPoint; ++i) {
+                int const neighbor(neighborList[i]);
+                if (remainingDegree[neighbor] != -1) {
+                    verticesByDegree[remainingDegree[neighbor]].erase(vertexLocator[neighbor]);
+
+                    neighborList[i] = neighborList[--splitPoint];
+                    neighborList[splitPoint] = neighbor;
+                    i--;
+
+                    remainingDegree[neighbor]--;
+                    verticesByDegree[remainingDegree[neighbor]].push_front(neighbor);
+                    vertexLocator[neighbor] = verticesByDegree[remainingDegree[neighbor]].begin();
+                }
+            }
+
+            earlierDegree[vertex] = splitPoint;
+
+            numVerticesRemoved++;
+            currentDegree = 0;
+        } else {
+            currentDegree++;
+        }
+    }
+
+    return vResult;
+}
@@ -99,6 +99,7 @@ int computeDegeneracy(std::vector<std::vector<int>> const &adjList, int size);
 NeighborList** computeDegeneracyOrderList(std::vector<std::list<int>> const &adjList, int size);
 
 NeighborListArray** computeDegeneracyOrderArray(std::vector<std::list<int>> const &adjList, int size);
+NeighborListArray** computeDegeneracyOrderArray(std::vector<std::list<int>> &&adjList, int size);
 
 std::vector<NeighborListArray> computeDegeneracyOrderArray(std::vector<std::vector<int>> &adjArray, int size);
 std::vector<NeighborListArray> computeDegeneracyOrderArrayWithArrays(std::vector<std::vector<int>> &adjArray, int size);
@@ -110,5 +111,6 @@ int neighborListComparator(void* nl1, void* nl2);
 std::vector<NeighborListArray> computeMaximumLaterOrderArray(std::vector<std::vector<int>> &adjArray, int size);
 
 std::vector<int> GetVerticesInDegeneracyOrder(std::vector<std::vector<int>> &adjArray);
+std::vector<int> GetVerticesInDegeneracyOrder(int** adjArray, int* degree, int* earlierDegree, int size);
 
 #endif
@@ -0,0 +1,403 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "DiskCliqueStore.h"
+
+// system includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+using namespace std;
+
+/*! \file DiskCliqueStore.cpp
+
+    \brief Store maximal cliques in files, for clique sets that do not fit
+           in memory, or that are reused by later runs.
+
+    A store is a directory with:
+
+     - segment-00000, segment-00001, ...: the cliques, appended in order,
+       each as its number of vertices, its first vertex, and the difference
+       of each further vertex to the previous one, all as varints (as in
+       the binary format of CliqueWriter). A segment holds at most the
+       segment size given to Create, and no clique spans two segments.
+     - index: for each clique, a 64-bit entry with its segment in the high
+       24 bits, and its offset in the segment in the low 40 bits.
+     - meta: the number of cliques and segments, and the attributes of the
+       store (e.g., the graph it was computed from), one per line. It is
+       written last, so a store without it is incomplete.
+
+    While the store is written, only the segment being filled is kept in
+    memory, along with as many index entries as fit in a segment; full
+    segments and chunks of the index are written out and memory-mapped, so
+    cliques can be read at any time, and the memory of a store being
+    written is bounded by twice the segment size. Complete stores are
+    opened by mapping the segments and the index, so the top-k selection
+    reads them at memory speed when they fit in the page cache, and lets
+    the operating system page them otherwise.
+*/
+
+namespace
+{
+    char const *MAGIC = "qc-clique-store";
+    int  const  VERSION = 1;
+
+    uint8_t const *MapFile(string const &fileName, size_t &size)
+    {
+        int const fd(open(fileName.c_str(), O_RDONLY));
+        if (fd < 0) return nullptr;
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size == 0) {
+            close(fd);
+            return nullptr;
+        }
+
+        size = status.st_size;
+        void *pMap(mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0));
+        close(fd);
+        return (pMap == MAP_FAILED) ? nullptr : static_cast<uint8_t const*>(pMap);
+    }
+
+    bool WriteFile(string const &fileName, void const *data, size_t const size)
+    {
+        FILE *file = fopen(fileName.c_str(), "wb");
+        if (file == nullptr) return false;
+        bool const bWritten(fwrite(data, 1, size, file) == size);
+        return (fclose(file) == 0) && bWritten;
+    }
+};
+
+DiskCliqueStore::DiskCliqueStore()
+ : m_sDirectory()
+ , m_bTemporary(false)
+ , m_bWritable(false)
+ , m_bFailed(false)
+ , m_vSegments()
+ , m_vSegmentSizes()
+ , m_pBuffer(nullptr)
+ , m_SegmentBytes(0)
+ , m_Used(0)
+ , m_pIndexFile(nullptr)
+ , m_vIndex()
+ , m_pIndex(nullptr)
+ , m_IndexMapSize(0)
+ , m_lNumIndexed(0)
+ , m_lNumCliques(0)
+ , m_vClique()
+ , m_vAttributes()
+{
+}
+
+DiskCliqueStore::~DiskCliqueStore()
+{
+    Close();
+}
+
+string DiskCliqueStore::GetSegmentName(size_t const segment) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "/segment-%05zu", segment);
+    return m_sDirectory + name;
+}
+
+/*! \brief start a new, empty store in a directory, which is created if
+           needed. A previous store in the directory is replaced.
+
+    \param bTemporary if true, the files are removed when the store is closed.
+    \param segmentBytes the size of the segments, at most SEGMENT_BYTES;
+           about twice this is kept in memory while the store is written.
+
+    \return true if the store was created.
+*/
+
+bool DiskCliqueStore::Create(string const &directory, bool const bTemporary, size_t const segmentBytes)
+{
+    Close();
+
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) return false;
+
+    m_sDirectory = directory;
+    m_bTemporary = bTemporary;
+    m_bWritable  = true;
+    m_bFailed    = false;
+
+    // the store is incomplete until Finish writes the meta file
+    remove((m_sDirectory + "/meta").c_str());
+
+    m_pIndexFile = fopen((m_sDirectory + "/index").c_str(), "wb");
+    if (m_pIndexFile == nullptr) return false;
+
+    // the buffer is not cleared, so only the pages written take memory
+    m_SegmentBytes = (segmentBytes < SEGMENT_BYTES) ? segmentBytes : SEGMENT_BYTES;
+    m_pBuffer = new uint8_t[m_SegmentBytes];
+    m_Used = 0;
+    m_vSegments.assign(1, m_pBuffer);
+    m_vSegmentSizes.assign(1, 0);
+    m_vIndex.clear();
+    m_vIndex.reserve(m_SegmentBytes / sizeof(uint64_t));
+    m_lNumIndexed = 0;
+    m_lNumCliques = 0;
+    return true;
+}
+
+void DiskCliqueStore::AddSorted()
+{
+    size_t const maxBytes((m_vClique.size() + 1) * Varint::MAX_BYTES);
+    if (maxBytes > m_SegmentBytes) {
+        fprintf(stderr, "ERROR: clique of %zu vertices is too large for the clique store\n", m_vClique.size());
+        exit(1);
+    }
+    if ((m_Used + maxBytes > m_SegmentBytes && !WriteSegment())
+     || (m_vIndex.size() == m_vIndex.capacity() && !WriteIndex())) {
+        fprintf(stderr, "ERROR: unable to write the clique store in %s\n", m_sDirectory.c_str());
+        exit(1);
+    }
+
+    m_vIndex.push_back((static_cast<uint64_t>(m_vSegments.size() - 1) << OFFSET_BITS) | m_Used);
+    m_lNumCliques++;
+
+    Varint::Put(m_pBuffer, m_Used, static_cast<uint32_t>(m_vClique.size()));
+    uint32_t previous(0);
+    for (int const vertex : m_vClique) {
+        Varint::Put(m_pBuffer, m_Used, static_cast<uint32_t>(vertex) - previous);
+        previous = static_cast<uint32_t>(vertex);
+    }
+}
+
+/*! \brief write out the segment being filled, map it, and start the next
+           segment in the buffer.
+*/
+
+bool DiskCliqueStore::WriteSegment()
+{
+    size_t const segment(m_vSegments.size() - 1);
+    string const segmentName(GetSegmentName(segment));
+    if (!WriteFile(segmentName, m_pBuffer, m_Used)) return false;
+
+    size_t size(0);
+    uint8_t const *pSegment(MapFile(segmentName, size));
+    if (pSegment == nullptr) return false;
+
+    m_vSegments[segment] = pSegment;
+    m_vSegmentSizes[segment] = size;
+    m_vSegments.push_back(m_pBuffer);
+    m_vSegmentSizes.push_back(0);
+    m_Used = 0;
+    return true;
+}
+
+/*! \brief append the index entries in memory to the index file, and map
+           the whole file again.
+*/
+
+bool DiskCliqueStore::WriteIndex()
+{
+    if (fwrite(m_vIndex.data(), sizeof(uint64_t), m_vIndex.size(), m_pIndexFile) != m_vIndex.size()
+     || fflush(m_pIndexFile) != 0) {
+        return false;
+    }
+
+    if (m_IndexMapSize > 0) munmap(const_cast<uint64_t*>(m_pIndex), m_IndexMapSize);
+    m_pIndex = nullptr;
+    m_IndexMapSize = 0;
+    m_lNumIndexed += m_vIndex.size();
+    m_vIndex.clear();
+    if (m_lNumIndexed == 0) return true;
+
+    m_pIndex = reinterpret_cast<uint64_t const*>(MapFile(m_sDirectory + "/index", m_IndexMapSize));
+    return (m_pIndex != nullptr) && (m_IndexMapSize == m_lNumIndexed * sizeof(uint64_t));
+}
+
+/*! \brief write out the last segment, the index, and the meta file, after
+           which the store is complete, and can no longer be added to.
+
+    \return true if the whole store was written.
+*/
+
+bool DiskCliqueStore::Finish()
+{
+    if (!m_bWritable) return !m_bFailed;
+    m_bWritable = false;
+
+    if (m_Used > 0) {
+        if (!WriteSegment()) m_bFailed = true;
+    }
+    if (!m_bFailed) {
+        m_vSegments.pop_back();
+        m_vSegmentSizes.pop_back();
+        delete[] m_pBuffer;
+        m_pBuffer = nullptr;
+        m_Used = 0;
+    }
+
+    if (!m_bFailed && !WriteIndex()) m_bFailed = true;
+    if (fclose(m_pIndexFile) != 0) m_bFailed = true;
+    m_pIndexFile = nullptr;
+    if (!m_bFailed) vector<uint64_t>().swap(m_vIndex);
+
+    if (!m_bFailed) {
+        string const metaName(m_sDirectory + "/meta");
+        FILE *file = fopen((metaName + ".tmp").c_str(), "w");
+        if (file == nullptr) {
+            m_bFailed = true;
+        } else {
+            fprintf(file, "%s %d\n", MAGIC, VERSION);
+            fprintf(file, "cliques %zu\n", m_lNumCliques);
+            fprintf(file, "segments %zu\n", m_vSegments.size());
+            for (pair<string, long> const &attribute : m_vAttributes) {
+                fprintf(file, "%s %ld\n", attribute.first.c_str(), attribute.second);
+            }
+            if (fclose(file) != 0 || rename((metaName + ".tmp").c_str(), metaName.c_str()) != 0) {
+                m_bFailed = true;
+            }
+        }
+    }
+
+    return !m_bFailed;
+}
+
+/*! \brief open a complete store, written by an earlier run.
+
+    \return true if the directory holds a complete store.
+*/
+
+bool DiskCliqueStore::Open(string const &directory)
+{
+    Close();
+    m_sDirectory = directory;
+
+    ifstream meta((m_sDirectory + "/meta").c_str());
+    string magic;
+    int version(0);
+    if (!(meta >> magic >> version) || magic != MAGIC || version != VERSION) return false;
+
+    m_vAttributes.clear();
+    string name;
+    long value(0);
+    while (meta >> name >> value) {
+        m_vAttributes.push_back(make_pair(name, value));
+    }
+
+    long numCliques(0), numSegments(0);
+    if (!GetAttribute("cliques", numCliques) || !GetAttribute("segments", numSegments)) return false;
+    m_vAttributes.erase(m_vAttributes.begin(), m_vAttributes.begin() + 2);
+
+    for (long segment = 0; segment < numSegments; ++segment) {
+        size_t size(0);
+        uint8_t const *pSegment(MapFile(GetSegmentName(segment), size));
+        if (pSegment == nullptr) {
+            Close();
+            return false;
+        }
+        m_vSegments.push_back(pSegment);
+        m_vSegmentSizes.push_back(size);
+    }
+
+    m_lNumCliques = numCliques;
+    if (m_lNumCliques > 0) {
+        m_pIndex = reinterpret_cast<uint64_t const*>(MapFile(m_sDirectory + "/index", m_IndexMapSize));
+        if (m_pIndex == nullptr || m_IndexMapSize != m_lNumCliques * sizeof(uint64_t)) {
+            Close();
+            return false;
+        }
+    }
+    m_lNumIndexed = m_lNumCliques;
+    return true;
+}
+
+void DiskCliqueStore::Close()
+{
+    for (size_t segment = 0; segment < m_vSegments.size(); ++segment) {
+        if (m_vSegmentSizes[segment] > 0) {
+            munmap(const_cast<uint8_t*>(m_vSegments[segment]), m_vSegmentSizes[segment]);
+        }
+    }
+    if (m_IndexMapSize > 0) {
+        munmap(const_cast<uint64_t*>(m_pIndex), m_IndexMapSize);
+    }
+    if (m_pIndexFile != nullptr) {
+        fclose(m_pIndexFile);
+    }
+
+    if (m_bTemporary) {
+        for (size_t segment = 0; segment < m_vSegments.size(); ++segment) {
+            remove(GetSegmentName(segment).c_str());
+        }
+        remove((m_sDirectory + "/index").c_str());
+        remove((m_sDirectory + "/meta").c_str());
+        rmdir(m_sDirectory.c_str());
+    }
+
+    m_vSegments.clear();
+    m_vSegmentSizes.clear();
+    delete[] m_pBuffer;
+    m_pBuffer = nullptr;
+    m_SegmentBytes = 0;
+    m_Used = 0;
+    m_pIndexFile = nullptr;
+    vector<uint64_t>().swap(m_vIndex);
+    m_pIndex = nullptr;
+    m_IndexMapSize = 0;
+    m_lNumIndexed = 0;
+    m_lNumCliques = 0;
+    m_bTemporary = false;
+    m_bWritable = false;
+}
+
+/*! \brief record a named value in the meta file of the store, e.g., the
+           number of vertices of the graph.
+*/
+
+void DiskCliqueStore::SetAttribute(string const &name, long const value)
+{
+    for (pair<string, long> &attribute : m_vAttributes) {
+        if (attribute.first == name) {
+            attribute.second = value;
+            return;
+        }
+    }
+    m_vAttributes.push_back(make_pair(name, value));
+}
+
+bool DiskCliqueStore::GetAttribute(string const &name, long &value) const
+{
+    for (pair<string, long> const &attribute : m_vAttributes) {
+        if (attribute.first == name) {
+            value = attribute.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t DiskCliqueStore::GetMemoryBytes() const
+{
+    return ((m_pBuffer != nullptr) ? m_SegmentBytes : 0) + m_vIndex.capacity() * sizeof(uint64_t);
+}
+
+size_t DiskCliqueStore::GetDiskBytes() const
+{
+    size_t bytes(m_lNumCliques * sizeof(uint64_t));
+    for (size_t const size : m_vSegmentSizes) bytes += size;
+    return bytes;
+}
@@ -0,0 +1,121 @@
+#ifndef DISK_CLIQUE_STORE_H
+#define DISK_CLIQUE_STORE_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "Varint.h"
+
+// system includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*! \file DiskCliqueStore.h
+
+    \brief see DiskCliqueStore.cpp
+*/
+
+class DiskCliqueStore
+{
+public:
+    //! the largest size of a segment file, in bytes
+    static size_t const SEGMENT_BYTES = 1 << 26;
+
+    DiskCliqueStore();
+    ~DiskCliqueStore();
+
+    DiskCliqueStore           (DiskCliqueStore const &) = delete;
+    DiskCliqueStore& operator=(DiskCliqueStore const &) = delete;
+
+    bool Create(std::string const &directory, bool const bTemporary, size_t const segmentBytes = SEGMENT_BYTES);
+    bool Open(std::string const &directory);
+    bool Finish();
+
+    void SetAttribute(std::string const &name, long const value);
+    bool GetAttribute(std::string const &name, long &value) const;
+
+    std::string const &GetDirectory() const { return m_sDirectory; }
+
+    /*! \brief append a clique, given by its vertices in any order.
+    */
+    template <typename Iterator>
+    void Add(Iterator begin, Iterator end)
+    {
+        m_vClique.assign(begin, end);
+        std::sort(m_vClique.begin(), m_vClique.end());
+        AddSorted();
+    }
+
+    /*! \brief call function on each vertex of a clique, in increasing order.
+    */
+    template <typename Function>
+    void ForEachVertex(size_t const index, Function function) const
+    {
+        uint64_t const entry((index < m_lNumIndexed) ? m_pIndex[index] : m_vIndex[index - m_lNumIndexed]);
+        uint8_t const *p(m_vSegments[entry >> OFFSET_BITS] + (entry & OFFSET_MASK));
+        uint32_t size(Varint::Get(p));
+        uint32_t vertex(0);
+        while (size-- > 0) {
+            vertex += Varint::Get(p);
+            function(static_cast<int>(vertex));
+        }
+    }
+
+    size_t size() const { return m_lNumCliques; }
+
+    size_t GetMemoryBytes() const;
+    size_t GetDiskBytes() const;
+
+private:
+    //! index entries hold the segment in the high bits, and the offset in
+    //! the segment in the low bits
+    static int      const OFFSET_BITS = 40;
+    static uint64_t const OFFSET_MASK = (uint64_t(1) << OFFSET_BITS) - 1;
+
+    void AddSorted();
+    bool WriteSegment();
+    bool WriteIndex();
+    void Close();
+    std::string GetSegmentName(size_t const segment) const;
+
+    std::string m_sDirectory;
+    bool m_bTemporary;                //!< remove the files when closed
+    bool m_bWritable;
+    bool m_bFailed;                   //!< a write failed
+
+    std::vector<uint8_t const*> m_vSegments;  //!< the mapped segments, then the buffer
+    std::vector<size_t> m_vSegmentSizes;      //!< the mapped size of each segment
+    uint8_t *m_pBuffer;                       //!< the segment being written
+    size_t m_SegmentBytes;                    //!< the size of m_pBuffer
+    size_t m_Used;                            //!< the number of bytes of m_pBuffer in use
+
+    FILE *m_pIndexFile;              //!< the index, while the store is written
+    std::vector<uint64_t> m_vIndex;  //!< the entries not written to the index yet
+    uint64_t const *m_pIndex;        //!< the mapped index
+    size_t m_IndexMapSize;
+    size_t m_lNumIndexed;            //!< the number of entries in the mapped index
+    size_t m_lNumCliques;
+
+    std::vector<int> m_vClique;
+    std::vector<std::pair<std::string, long>> m_vAttributes;
+};
+
+#endif //DISK_CLIQUE_STORE_H
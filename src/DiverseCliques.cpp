@@ -0,0 +1,148 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "DiverseCliques.h"
+
+// system includes
+#include <algorithm>
+
+using namespace std;
+
+/*! \file DiverseCliques.cpp
+
+    \brief Choose K large cliques from a stream, such that any two chosen
+           cliques share at most a fraction tau of the smaller one.
+
+    Each vertex lists the chosen cliques that contain it, so the overlap of
+    an offered clique with every chosen clique is counted by visiting the
+    vertices of the offered clique once, with no pairwise comparisons. An
+    offered clique that overlaps no chosen clique is added, replacing the
+    smallest one once K are chosen; one that overlaps exactly one chosen
+    clique replaces it if it is larger; any other clique is dropped.
+
+    The choice only changes for cliques larger than the smallest chosen
+    clique, so once K cliques are chosen, their smallest size is a lower
+    bound for the enumeration (see CliqueGenerator::SetSizeThreshold),
+    and it never decreases.
+*/
+
+DiverseCliques::DiverseCliques(int const numVertices, int const K, double const overlap)
+ : m_iK(max(K, 0))
+ , m_dOverlap(overlap)
+ , m_vSlots()
+ , m_vOwners(max(numVertices, 0))
+ , m_vShared(max(K, 0), 0)
+ , m_vTouched()
+ , m_Threshold(0)
+ , m_lNumSwaps(0)
+{
+    m_vSlots.reserve(m_iK);
+}
+
+bool DiverseCliques::Overlaps(size_t const size, size_t const shared, size_t const otherSize) const
+{
+    return shared > m_dOverlap * min(size, otherSize);
+}
+
+void DiverseCliques::Remove(int const slot)
+{
+    for (int const vertex : m_vSlots[slot]) {
+        vector<int> &owners(m_vOwners[vertex]);
+        owners.erase(find(owners.begin(), owners.end(), slot));
+    }
+    m_vSlots[slot].clear();
+}
+
+void DiverseCliques::Insert(int const slot, int const *begin, int const *end)
+{
+    m_vSlots[slot].assign(begin, end);
+    for (int const *vertex = begin; vertex != end; ++vertex) {
+        m_vOwners[*vertex].push_back(slot);
+    }
+}
+
+void DiverseCliques::UpdateThreshold()
+{
+    if (static_cast<int>(m_vSlots.size()) < m_iK) return;
+    m_Threshold = m_vSlots[0].size();
+    for (vector<int> const &clique : m_vSlots) {
+        m_Threshold = min(m_Threshold, clique.size());
+    }
+}
+
+/*! \brief offer a clique for the choice.
+
+    \return true if the clique was chosen.
+*/
+
+bool DiverseCliques::Offer(int const *begin, int const *end)
+{
+    size_t const size(end - begin);
+    if (m_iK == 0 || size <= m_Threshold) return false;
+
+    // count the vertices shared with each chosen clique
+    for (int const *vertex = begin; vertex != end; ++vertex) {
+        for (int const slot : m_vOwners[*vertex]) {
+            if (m_vShared[slot]++ == 0) m_vTouched.push_back(slot);
+        }
+    }
+
+    int conflict(-1);
+    int numConflicts(0);
+    for (int const slot : m_vTouched) {
+        if (Overlaps(size, m_vShared[slot], m_vSlots[slot].size())) {
+            conflict = slot;
+            numConflicts++;
+        }
+        m_vShared[slot] = 0;
+    }
+    m_vTouched.clear();
+
+    if (numConflicts == 0) {
+        if (static_cast<int>(m_vSlots.size()) < m_iK) {
+            m_vSlots.emplace_back();
+            Insert(m_vSlots.size() - 1, begin, end);
+        } else {
+            // the threshold is the size of the smallest clique
+            int smallest(0);
+            for (int slot = 1; slot < m_iK; ++slot) {
+                if (m_vSlots[slot].size() < m_vSlots[smallest].size()) smallest = slot;
+            }
+            Remove(smallest);
+            Insert(smallest, begin, end);
+        }
+    } else if (numConflicts == 1 && size > m_vSlots[conflict].size()) {
+        Remove(conflict);
+        Insert(conflict, begin, end);
+        m_lNumSwaps++;
+    } else {
+        return false;
+    }
+
+    UpdateThreshold();
+    return true;
+}
+
+/*! \brief the chosen cliques, from largest to smallest.
+*/
+
+vector<vector<int>> DiverseCliques::GetCliques() const
+{
+    vector<vector<int>> cliques(m_vSlots);
+    stable_sort(cliques.begin(), cliques.end(),
+                [](vector<int> const &left, vector<int> const &right) { return left.size() > right.size(); });
+    return cliques;
+}
@@ -0,0 +1,60 @@
+#ifndef DIVERSE_CLIQUES_H
+#define DIVERSE_CLIQUES_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <cstddef>
+#include <vector>
+
+/*! \file DiverseCliques.h
+
+    \brief see DiverseCliques.cpp
+*/
+
+class DiverseCliques
+{
+public:
+    DiverseCliques(int const numVertices, int const K, double const overlap);
+
+    bool Offer(int const *begin, int const *end);
+
+    /*! \brief no clique of at most this many vertices can enter the
+               choice; 0 until K cliques were chosen.
+    */
+    size_t GetThreshold() const { return m_Threshold; }
+
+    std::vector<std::vector<int>> GetCliques() const;
+
+    long GetNumSwaps() const { return m_lNumSwaps; }
+
+private:
+    bool Overlaps(size_t const size, size_t const shared, size_t const otherSize) const;
+    void Remove(int const slot);
+    void Insert(int const slot, int const *begin, int const *end);
+    void UpdateThreshold();
+
+    int m_iK;
+    double m_dOverlap;                       //!< the largest fraction of the smaller clique two chosen cliques share
+    std::vector<std::vector<int>> m_vSlots;  //!< the chosen cliques
+    std::vector<std::vector<int>> m_vOwners; //!< the slots of the chosen cliques that contain each vertex
+    std::vector<int> m_vShared;              //!< the vertices the offered clique shares with each slot
+    std::vector<int> m_vTouched;             //!< the slots with nonzero entries in m_vShared
+    size_t m_Threshold;
+    long m_lNumSwaps;
+};
+
+#endif //DIVERSE_CLIQUES_H
@@ -0,0 +1,224 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "EnumerationStatistics.h"
+
+// system includes
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+/*! \file EnumerationStatistics.cpp
+
+    \brief Instrumentation of the delay of a clique enumeration: the number
+           of recursive calls and the time (in nanoseconds) between
+           consecutive reported cliques, the number of recursive calls
+           made at each depth of the search tree, and, for algorithms that
+           search root by root, the time and calls spent on each root.
+
+    Each run (or each thread of a run) fills its own instance, which
+    can be merged afterwards, so no state is shared while enumerating.
+*/
+
+EnumerationStatistics::EnumerationStatistics()
+ : m_ulNumNodes(0)
+ , m_ulNumCliques(0)
+ , m_ulStepsSinceLastClique(0)
+ , m_ulLargestDifference(0)
+ , m_ulNumLargeJumps(0)
+ , m_ulMaxSteps(0)
+ , m_ulMaxNanos(0)
+ , m_LastClique(Clock::now())
+ , m_vNodesPerDepth()
+ , m_vStepsHistogram(NUM_BUCKETS, 0)
+ , m_vNanosHistogram(NUM_BUCKETS, 0)
+ , m_iCurrentRoot(-1)
+ , m_RootStart()
+ , m_ulRootStartNodes(0)
+ , m_vRootSeconds()
+ , m_vRootNodes()
+{
+}
+
+void EnumerationStatistics::Clear()
+{
+    *this = EnumerationStatistics();
+}
+
+/*! \brief mark the start of an enumeration; the delay before the first
+           clique is measured from here.
+*/
+
+void EnumerationStatistics::Start()
+{
+    m_ulStepsSinceLastClique = 0;
+    m_LastClique = Clock::now();
+}
+
+int EnumerationStatistics::GetBucket(unsigned long const value)
+{
+    int bucket(0);
+    unsigned long remaining(value);
+    while (remaining != 0) {
+        bucket++;
+        remaining >>= 1;
+    }
+    return bucket;
+}
+
+/*! \brief record that a maximal clique was reported, and the delay since
+           the previous one.
+*/
+
+void EnumerationStatistics::RecordClique(size_t const cliqueSize)
+{
+    Clock::time_point const now(Clock::now());
+    unsigned long const nanos(chrono::duration_cast<chrono::nanoseconds>(now - m_LastClique).count());
+    m_LastClique = now;
+
+    m_ulNumCliques++;
+
+    if (m_ulStepsSinceLastClique > cliqueSize) {
+        m_ulNumLargeJumps++;
+        m_ulLargestDifference = max(m_ulLargestDifference, m_ulStepsSinceLastClique - cliqueSize);
+    }
+
+    m_ulMaxSteps = max(m_ulMaxSteps, m_ulStepsSinceLastClique);
+    m_ulMaxNanos = max(m_ulMaxNanos, nanos);
+    m_vStepsHistogram[GetBucket(m_ulStepsSinceLastClique)]++;
+    m_vNanosHistogram[GetBucket(nanos)]++;
+
+    m_ulStepsSinceLastClique = 0;
+}
+
+/*! \brief record that the search of a root begins, which ends the search
+           of the previous root.
+*/
+
+void EnumerationStatistics::StartRoot(int const root)
+{
+    FinishRoot();
+    m_iCurrentRoot = root;
+    m_ulRootStartNodes = m_ulNumNodes;
+    m_RootStart = Clock::now();
+}
+
+/*! \brief record that the search of the current root is complete.
+*/
+
+void EnumerationStatistics::FinishRoot()
+{
+    if (m_iCurrentRoot < 0) return;
+
+    size_t const root(m_iCurrentRoot);
+    if (root >= m_vRootSeconds.size()) {
+        m_vRootSeconds.resize(root + 1, 0.0);
+        m_vRootNodes.resize(root + 1, 0);
+    }
+    m_vRootSeconds[root] += chrono::duration<double>(Clock::now() - m_RootStart).count();
+    m_vRootNodes[root]   += m_ulNumNodes - m_ulRootStartNodes;
+    m_iCurrentRoot = -1;
+}
+
+void EnumerationStatistics::Merge(EnumerationStatistics const &other)
+{
+    m_ulNumNodes   += other.m_ulNumNodes;
+    m_ulNumCliques += other.m_ulNumCliques;
+    m_ulNumLargeJumps += other.m_ulNumLargeJumps;
+    m_ulLargestDifference = max(m_ulLargestDifference, other.m_ulLargestDifference);
+    m_ulMaxSteps = max(m_ulMaxSteps, other.m_ulMaxSteps);
+    m_ulMaxNanos = max(m_ulMaxNanos, other.m_ulMaxNanos);
+
+    if (m_vNodesPerDepth.size() < other.m_vNodesPerDepth.size()) {
+        m_vNodesPerDepth.resize(other.m_vNodesPerDepth.size(), 0);
+    }
+    for (size_t depth = 0; depth < other.m_vNodesPerDepth.size(); ++depth) {
+        m_vNodesPerDepth[depth] += other.m_vNodesPerDepth[depth];
+    }
+
+    for (int bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+        m_vStepsHistogram[bucket] += other.m_vStepsHistogram[bucket];
+        m_vNanosHistogram[bucket] += other.m_vNanosHistogram[bucket];
+    }
+
+    if (m_vRootSeconds.size() < other.m_vRootSeconds.size()) {
+        m_vRootSeconds.resize(other.m_vRootSeconds.size(), 0.0);
+        m_vRootNodes.resize(other.m_vRootNodes.size(), 0);
+    }
+    for (size_t root = 0; root < other.m_vRootSeconds.size(); ++root) {
+        m_vRootSeconds[root] += other.m_vRootSeconds[root];
+        m_vRootNodes[root]   += other.m_vRootNodes[root];
+    }
+}
+
+/*! \brief an upper bound on the given percentile of a histogram: the
+           largest value that falls in the bucket containing the percentile.
+*/
+
+unsigned long EnumerationStatistics::GetPercentile(vector<unsigned long> const &histogram, double const fraction)
+{
+    unsigned long total(0);
+    for (unsigned long const count : histogram) total += count;
+    if (total == 0) return 0;
+
+    unsigned long const target(static_cast<unsigned long>(fraction * (total - 1)) + 1);
+    unsigned long seen(0);
+    for (int bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+        seen += histogram[bucket];
+        if (seen >= target) {
+            if (bucket == 0) return 0;
+            if (bucket == NUM_BUCKETS - 1) return ~0UL;
+            return (1UL << bucket) - 1;
+        }
+    }
+    return ~0UL;
+}
+
+namespace
+{
+    void PrintHistogram(ostream &out, char const *name, vector<unsigned long> const &histogram)
+    {
+        out << name << ":" << endl;
+        for (int bucket = 0; bucket < EnumerationStatistics::NUM_BUCKETS; ++bucket) {
+            if (histogram[bucket] == 0) continue;
+            unsigned long const low(bucket == 0 ? 0 : (1UL << (bucket - 1)));
+            out << "  >= " << setw(20) << low << " : " << histogram[bucket] << endl;
+        }
+    }
+};
+
+void EnumerationStatistics::Print(ostream &out) const
+{
+    out << "Search tree nodes     : " << m_ulNumNodes << endl;
+    out << "Maximal cliques       : " << m_ulNumCliques << endl;
+    out << "Steps between cliques : p50 <= " << GetPercentile(m_vStepsHistogram, 0.50)
+        << ", p99 <= " << GetPercentile(m_vStepsHistogram, 0.99)
+        << ", max " << m_ulMaxSteps << endl;
+    out << "Nanos between cliques : p50 <= " << GetPercentile(m_vNanosHistogram, 0.50)
+        << ", p99 <= " << GetPercentile(m_vNanosHistogram, 0.99)
+        << ", max " << m_ulMaxNanos << endl;
+    out << "Largest difference    : " << m_ulLargestDifference << endl;
+    out << "Num large jumps       : " << m_ulNumLargeJumps << endl;
+    PrintHistogram(out, "Steps between cliques", m_vStepsHistogram);
+    PrintHistogram(out, "Nanoseconds between cliques", m_vNanosHistogram);
+    out << "Nodes per depth:" << endl;
+    for (size_t depth = 0; depth < m_vNodesPerDepth.size(); ++depth) {
+        if (m_vNodesPerDepth[depth] == 0) continue;
+        out << "  " << setw(6) << depth << " : " << m_vNodesPerDepth[depth] << endl;
+    }
+    out << flush;
+}
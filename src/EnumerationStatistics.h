@@ -0,0 +1,100 @@
+#ifndef ENUMERATION_STATISTICS_H
+#define ENUMERATION_STATISTICS_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <chrono>
+#include <vector>
+#include <ostream>
+
+/*! \file EnumerationStatistics.h
+
+    \brief see EnumerationStatistics.cpp
+*/
+
+class EnumerationStatistics
+{
+public:
+    //! histograms bucket a value v into bucket 0 if v == 0, and bucket
+    //! floor(log2(v))+1 otherwise.
+    static int const NUM_BUCKETS = 65;
+
+    EnumerationStatistics();
+
+    void Clear();
+    void Start();
+
+    /*! \brief record a call of the recursive search, at the given depth (= |R|)
+    */
+    inline void RecordNode(size_t const depth)
+    {
+        m_ulStepsSinceLastClique++;
+        m_ulNumNodes++;
+        if (depth >= m_vNodesPerDepth.size()) m_vNodesPerDepth.resize(depth + 1, 0);
+        m_vNodesPerDepth[depth]++;
+    }
+
+    void RecordClique(size_t const cliqueSize);
+
+    void StartRoot(int const root);
+    void FinishRoot();
+
+    void Merge(EnumerationStatistics const &other);
+
+    unsigned long GetNumNodes() const          { return m_ulNumNodes;           }
+    unsigned long GetNumCliques() const        { return m_ulNumCliques;         }
+    unsigned long GetLargestDifference() const { return m_ulLargestDifference;  }
+    unsigned long GetNumLargeJumps() const     { return m_ulNumLargeJumps;      }
+    unsigned long GetMaxStepsBetweenCliques() const { return m_ulMaxSteps;      }
+    unsigned long GetMaxNanosBetweenCliques() const { return m_ulMaxNanos;      }
+
+    std::vector<unsigned long> const &GetNodesPerDepth() const { return m_vNodesPerDepth; }
+    std::vector<unsigned long> const &GetStepsHistogram() const { return m_vStepsHistogram; }
+    std::vector<unsigned long> const &GetNanosHistogram() const { return m_vNanosHistogram; }
+    std::vector<double>        const &GetRootSeconds()    const { return m_vRootSeconds;    }
+    std::vector<unsigned long> const &GetRootNodes()      const { return m_vRootNodes;      }
+
+    static int GetBucket(unsigned long const value);
+    static unsigned long GetPercentile(std::vector<unsigned long> const &histogram, double const fraction);
+
+    void Print(std::ostream &out) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    unsigned long m_ulNumNodes;
+    unsigned long m_ulNumCliques;
+    unsigned long m_ulStepsSinceLastClique;
+    unsigned long m_ulLargestDifference; //!< largest (steps - clique size) between consecutive cliques
+    unsigned long m_ulNumLargeJumps;     //!< number of times steps between cliques exceeded the clique size
+    unsigned long m_ulMaxSteps;
+    unsigned long m_ulMaxNanos;
+    Clock::time_point m_LastClique;
+
+    std::vector<unsigned long> m_vNodesPerDepth;
+    std::vector<unsigned long> m_vStepsHistogram;
+    std::vector<unsigned long> m_vNanosHistogram;
+
+    // work per root of the search, for algorithms that search root by root
+    int m_iCurrentRoot;                   //!< -1 if no root is being searched
+    Clock::time_point m_RootStart;
+    unsigned long m_ulRootStartNodes;
+    std::vector<double> m_vRootSeconds;
+    std::vector<unsigned long> m_vRootNodes;
+};
+
+#endif //ENUMERATION_STATISTICS_H
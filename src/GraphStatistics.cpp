@@ -0,0 +1,202 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "GraphStatistics.h"
+#include "DegeneracyTools.h"
+#include "BitSetTomitaAlgorithm.h"
+#include "MemoryManager.h"
+
+// system includes
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+/*! \file GraphStatistics.cpp
+
+    \brief Cheap statistics of an input graph (number of vertices and edges,
+           maximum degree, degeneracy, and a sampled estimate of the local
+           edge density), used to choose the enumeration algorithm
+           for --algorithm=auto.
+
+    The degeneracy comes from the degeneracy order, which is kept for
+    DegeneracyAlgorithm in case --algorithm=auto chooses it, so the order
+    is only computed once.
+
+    The local density is the mean, over a sample of evenly spaced vertices,
+    of the fraction of pairs of neighbors that are adjacent (the local
+    clustering coefficient), estimated from at most NUM_SAMPLED_NEIGHBORS
+    evenly spaced neighbors of each sampled vertex. Each pair of those
+    neighbors is adjacent if one is a later neighbor of the other, so a
+    sample costs at most NUM_SAMPLED_NEIGHBORS x degeneracy steps, even
+    when the sampled vertex or its neighbors are hubs.
+*/
+
+GraphStatistics::GraphStatistics()
+ : m_lNumVertices(0)
+ , m_lNumEdges(0)
+ , m_iMaxDegree(0)
+ , m_iDegeneracy(0)
+ , m_dLocalDensity(0.0)
+ , m_pOrderingArray(nullptr)
+{
+}
+
+GraphStatistics::~GraphStatistics()
+{
+    FreeOrderingArray();
+}
+
+void GraphStatistics::FreeOrderingArray()
+{
+    if (m_pOrderingArray == nullptr) return;
+    for (long i = 0; i < m_lNumVertices; i++) {
+        delete m_pOrderingArray[i];
+    }
+    Free(m_pOrderingArray);
+    m_pOrderingArray = nullptr;
+}
+
+/*! \brief hand over the degeneracy order computed by Compute, e.g., to
+           DegeneracyAlgorithm, which then owns it.
+
+    \return the ordering array, indexed by vertex, or nullptr if it was
+            already released.
+*/
+
+NeighborListArray** GraphStatistics::ReleaseOrderingArray()
+{
+    NeighborListArray **pOrderingArray(m_pOrderingArray);
+    m_pOrderingArray = nullptr;
+    return pOrderingArray;
+}
+
+void GraphStatistics::Compute(vector<list<int>> const &adjacencyList)
+{
+    FreeOrderingArray();
+
+    m_lNumVertices = adjacencyList.size();
+    m_lNumEdges    = 0;
+    m_iMaxDegree   = 0;
+
+    for (list<int> const &neighbors : adjacencyList) {
+        m_lNumEdges += neighbors.size();
+        m_iMaxDegree = max(m_iMaxDegree, static_cast<int>(neighbors.size()));
+    }
+    m_lNumEdges /= 2;
+
+    // the degeneracy is the largest number of later neighbors in the order
+    m_iDegeneracy   = 0;
+    m_dLocalDensity = 0.0;
+    if (m_lNumVertices == 0) return;
+    m_pOrderingArray = computeDegeneracyOrderArray(adjacencyList, m_lNumVertices);
+    for (long vertex = 0; vertex < m_lNumVertices; ++vertex) {
+        m_iDegeneracy = max(m_iDegeneracy, m_pOrderingArray[vertex]->laterDegree);
+    }
+
+    // sample evenly spaced vertices, and evenly spaced neighbors of each,
+    // so the estimate is deterministic
+    vector<char> vMarked(m_lNumVertices, 0);
+    vector<int> vSampledNeighbors;
+    long const stride(max(1L, m_lNumVertices/NUM_SAMPLES));
+    double totalDensity(0.0);
+    int numSampled(0);
+    for (long vertex = 0; vertex < m_lNumVertices; vertex += stride) {
+        NeighborListArray const &neighbors(*m_pOrderingArray[vertex]);
+        long const degree(neighbors.earlierDegree + neighbors.laterDegree);
+        if (degree < 2) continue;
+
+        long const numSampledNeighbors(min(degree, static_cast<long>(NUM_SAMPLED_NEIGHBORS)));
+        vSampledNeighbors.clear();
+        for (long i = 0; i < numSampledNeighbors; ++i) {
+            long const index(i*degree/numSampledNeighbors);
+            int const neighbor((index < neighbors.earlierDegree) ? neighbors.earlier[index] : neighbors.later[index - neighbors.earlierDegree]);
+            vSampledNeighbors.push_back(neighbor);
+            vMarked[neighbor] = 1;
+        }
+
+        // each adjacent pair is found from the endpoint earlier in the order
+        long numAdjacentPairs(0);
+        for (int const neighbor : vSampledNeighbors) {
+            NeighborListArray const &secondNeighbors(*m_pOrderingArray[neighbor]);
+            for (int i = 0; i < secondNeighbors.laterDegree; ++i) {
+                numAdjacentPairs += vMarked[secondNeighbors.later[i]];
+            }
+        }
+
+        for (int const neighbor : vSampledNeighbors) vMarked[neighbor] = 0;
+
+        totalDensity += 2.0*numAdjacentPairs/static_cast<double>(numSampledNeighbors*(numSampledNeighbors - 1));
+        numSampled++;
+    }
+
+    m_dLocalDensity = (numSampled == 0) ? 0.0 : totalDensity/numSampled;
+}
+
+double GraphStatistics::GetDensity() const
+{
+    if (m_lNumVertices < 2) return 0.0;
+    return 2.0*m_lNumEdges/(static_cast<double>(m_lNumVertices)*(m_lNumVertices - 1));
+}
+
+/*! \brief choose the algorithm predicted to be fastest for this graph.
+
+    \param reason On return, a short explanation of the choice.
+
+    \return the name of the algorithm, as accepted by --algorithm.
+*/
+
+string GraphStatistics::ChooseAlgorithm(string &reason) const
+{
+    stringstream strm;
+    string algorithm;
+
+    // The matrix algorithms answer adjacency queries in O(1), which pays
+    // off when the neighborhoods searched are large and dense; on sparse
+    // graphs their scans over rows of the matrix dominate. The packed
+    // matrix is as fast as the char matrix and an eighth of its size.
+    bool const bMatrixFits(m_lNumVertices < BitSetTomitaAlgorithm::MAX_VERTICES);
+    bool const bDenseCore(m_iDegeneracy >= 32 || (m_iDegeneracy >= 16 && m_dLocalDensity >= 0.5));
+    if (bMatrixFits && bDenseCore) {
+        algorithm = "bitset";
+        strm << "fewer than " << BitSetTomitaAlgorithm::MAX_VERTICES << " vertices, degeneracy " << m_iDegeneracy
+             << " and local density " << m_dLocalDensity << " indicate a dense core";
+    } else if (m_iMaxDegree > 4*m_iDegeneracy) {
+        // with high-degree hubs, arrays of neighbors in P keep the pivot
+        // computation proportional to the small later neighborhoods
+        algorithm = "degeneracy";
+        strm << "max degree " << m_iMaxDegree << " > 4 x degeneracy " << m_iDegeneracy;
+    } else {
+        // with no hubs, maintaining the arrays of neighbors in P costs more than it saves
+        algorithm = "hybrid";
+        strm << "max degree " << m_iMaxDegree << " <= 4 x degeneracy " << m_iDegeneracy;
+    }
+
+    reason = strm.str();
+    return algorithm;
+}
+
+void GraphStatistics::Print(ostream &out) const
+{
+    out << "Vertices         : " << m_lNumVertices << endl;
+    out << "Edges            : " << m_lNumEdges << endl;
+    out << "Max degree       : " << m_iMaxDegree << endl;
+    out << "Degeneracy       : " << m_iDegeneracy << endl;
+    out << "Density          : " << GetDensity() << endl;
+    out << "Local density    : " << m_dLocalDensity << endl;
+    out << flush;
+}
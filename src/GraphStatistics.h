@@ -0,0 +1,74 @@
+#ifndef GRAPH_STATISTICS_H
+#define GRAPH_STATISTICS_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "DegeneracyTools.h"
+
+// system includes
+#include <list>
+#include <string>
+#include <vector>
+#include <ostream>
+
+/*! \file GraphStatistics.h
+
+    \brief see GraphStatistics.cpp
+*/
+
+class GraphStatistics
+{
+public:
+    //! the number of vertices whose neighborhoods are sampled for the local density
+    static int const NUM_SAMPLES = 256;
+
+    //! the number of neighbors of a sampled vertex whose pairs are tested for adjacency
+    static int const NUM_SAMPLED_NEIGHBORS = 32;
+
+    GraphStatistics();
+    ~GraphStatistics();
+
+    void Compute(std::vector<std::list<int>> const &adjacencyList);
+
+    NeighborListArray** ReleaseOrderingArray();
+
+    long   GetNumVertices()  const { return m_lNumVertices;  }
+    long   GetNumEdges()     const { return m_lNumEdges;     }
+    int    GetMaxDegree()    const { return m_iMaxDegree;    }
+    int    GetDegeneracy()   const { return m_iDegeneracy;   }
+    double GetDensity()      const;
+    double GetLocalDensity() const { return m_dLocalDensity; }
+
+    std::string ChooseAlgorithm(std::string &reason) const;
+
+    void Print(std::ostream &out) const;
+
+private:
+    long   m_lNumVertices;
+    long   m_lNumEdges;
+    int    m_iMaxDegree;
+    int    m_iDegeneracy;
+    double m_dLocalDensity; //!< mean edge density of sampled neighborhoods
+    NeighborListArray **m_pOrderingArray; //!< the degeneracy order, until released
+
+    void FreeOrderingArray();
+
+    GraphStatistics           (GraphStatistics const &) = delete;
+    GraphStatistics& operator=(GraphStatistics const &) = delete;
+};
+
+#endif //GRAPH_STATISTICS_H
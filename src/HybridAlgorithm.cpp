@@ -0,0 +1,247 @@
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "HybridAlgorithm.h"
+#include "DegeneracyTools.h"
+#include "Tools.h"
+#include "MemoryManager.h"
+
+// system includes
+#include <cstdio>
+#include <list>
+#include <vector>
+
+using namespace std;
+
+/*! \file HybridAlgorithm.cpp
+
+    \brief This file contains the algorithm for listing all maximal cliques
+           according to the algorithm of Eppstein et al. (ISAAC 2010/SEA 2011),
+           using the adjacency lists of AdjacencyListAlgorithm in the recursion.
+
+    \author Darren Strash (first name DOT last name AT gmail DOT com)
+
+    \copyright Copyright (c) 2011 Darren Strash. This code is released under the GNU Public License (GPL) 3.0.
+
+    \image html gplv3-127x51.png
+
+    \htmlonly
+    <center>
+    <a href="gpl-3.0-standalone.html">See GPL 3.0 here</a>
+    </center>
+    \endhtmlonly
+
+    The outer loop visits the vertices in degeneracy order, and starts
+    a search with P set to the later neighbors and X set to the earlier
+    neighbors of each vertex, exactly as DegeneracyAlgorithm does. Below
+    the top level, the search is the adjacency list version of the
+    algorithm of Tomita et al., so no sets of neighbors in P are
+    maintained.
+*/
+
+HybridAlgorithm::HybridAlgorithm(vector<list<int>> &&adjacencyList)
+ : AdjacencyListAlgorithm(std::move(adjacencyList))
+ , m_vOrdering()
+ , m_EarlierDegree(nullptr)
+{
+    SetName("hybrid");
+
+    // neighbor arrays are permuted to |--earlier--|--later--|
+    m_EarlierDegree = (int*)Calloc(m_iNumVertices, sizeof(int));
+    m_vOrdering = GetVerticesInDegeneracyOrder(m_AdjacencyList, m_Degree, m_EarlierDegree, m_iNumVertices);
+}
+
+HybridAlgorithm::~HybridAlgorithm()
+{
+    Free(m_EarlierDegree);
+}
+
+long HybridAlgorithm::Run(list<list<int>> &cliques)
+{
+    return listAllMaximalCliquesHybrid();
+}
+
+/*! \brief Move vertex to R, set P to vertex's later neighbors and
+           set X to vertex's earlier neighbors.
+
+    \param vertex The vertex to move to R.
+
+    \param adjacencyList An array of arrays, the neighbors of each vertex,
+                         with the earlier neighbors first.
+
+    \param degree An array, indexed by vertex, containing the degree of that vertex.
+
+    \param earlierDegree An array, indexed by vertex, containing the number of
+                         earlier neighbors of that vertex.
+
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R, and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param pBeginX The index where set X begins in vertexSets.
+ 
+    \param pBeginP The index where set P begins in vertexSets.
+
+    \param pBeginR The index where set R begins in vertexSets.
+
+    \param pNewBeginX After function, contains the new index where set X begins
+                      in vertexSets after adding vertex to R.
+ 
+    \param pNewBeginP After function, contains the new index where set P begins
+                      in vertexSets after adding vertex to P.
+
+    \param pNewBeginR After function, contains the new index where set R begins
+                      in vertexSets after adding vertex to R.
+*/
+
+inline void fillInPandXForRecursiveCallHybrid( int vertex,
+                                               int** adjacencyList, int* degree, int* earlierDegree,
+                                               int* vertexSets, int* vertexLookup, 
+                                               int* pBeginX, int *pBeginP, int *pBeginR, 
+                                               int* pNewBeginX, int* pNewBeginP, int *pNewBeginR)
+{
+    int vertexLocation = vertexLookup[vertex];
+
+    (*pBeginR)--;
+    vertexSets[vertexLocation] = vertexSets[*pBeginR];
+    vertexLookup[vertexSets[*pBeginR]] = vertexLocation;
+    vertexSets[*pBeginR] = vertex;
+    vertexLookup[vertex] = *pBeginR;
+
+    *pNewBeginR = *pBeginR;
+    *pNewBeginP = *pBeginR;
+
+    // swap later neighbors of vertex into P section of vertexSets
+    int j = earlierDegree[vertex];
+    while(j<degree[vertex])
+    {
+        int neighbor = adjacencyList[vertex][j];
+        int neighborLocation = vertexLookup[neighbor];
+
+        (*pNewBeginP)--;
+
+        vertexSets[neighborLocation] = vertexSets[*pNewBeginP];
+        vertexLookup[vertexSets[*pNewBeginP]] = neighborLocation;
+        vertexSets[*pNewBeginP] = neighbor;
+        vertexLookup[neighbor] = *pNewBeginP;
+
+        j++; 
+    }
+
+    *pNewBeginX = *pNewBeginP;
+
+    // swap earlier neighbors of vertex into X section of vertexSets
+    j = 0;
+    while(j<earlierDegree[vertex])
+    {
+        int neighbor = adjacencyList[vertex][j];
+        int neighborLocation = vertexLookup[neighbor];
+
+        (*pNewBeginX)--;
+        vertexSets[neighborLocation] = vertexSets[*pNewBeginX];
+        vertexLookup[vertexSets[*pNewBeginX]] = neighborLocation;
+        vertexSets[*pNewBeginX] = neighbor;
+        vertexLookup[neighbor] = *pNewBeginX;
+
+        j++; 
+    }
+}
+
+/*! \brief List all maximal cliques in the graph using the algorithm
+           by Eppstein et al. (ISAAC 2010/SEA 2011), with adjacency lists
+           below the top level of the recursion.
+
+    \return the number of maximal cliques of the input graph.
+*/
+
+long HybridAlgorithm::listAllMaximalCliquesHybrid()
+{
+    int const size(m_iNumVertices);
+
+    // vertex sets are stored in an array like this:
+    // |--X--|--P--|--R--|
+    int* vertexSets = (int*)Calloc(size, sizeof(int));
+
+    // vertex i is stored in vertexSets[vertexLookup[i]]
+    int* vertexLookup = (int*)Calloc(size, sizeof(int));
+
+    int i = 0;
+    while(i<size)
+    {
+        vertexLookup[i] = i;
+        vertexSets[i] = i;
+        i++;
+    }
+
+    int beginX = 0;
+    int beginP = 0;
+    int beginR = size;
+
+    long cliqueCount = 0;
+
+    list<int> partialClique;
+
+    // statistics are gathered locally, and published when the run completes
+    EnumerationStatistics statistics;
+    EnumerationStatistics* pStatistics = GetCollectStatistics() ? &statistics : nullptr;
+    ClearStatistics();
+    if (pStatistics) pStatistics->Start();
+
+    // for each vertex, in degeneracy order
+    for (int const vertex : m_vOrdering)
+    {
+        #ifdef PRINT_CLIQUES_TOMITA_STYLE
+        printf("%d ", vertex);
+        #endif
+
+        // add vertex to partial clique R
+        partialClique.push_back(vertex);
+
+        int newBeginX, newBeginP, newBeginR;
+
+        // set P to be later neighbors and X to be be earlier neighbors
+        // of vertex
+        fillInPandXForRecursiveCallHybrid( vertex,
+                                           m_AdjacencyList, m_Degree, m_EarlierDegree,
+                                           vertexSets, vertexLookup, 
+                                           &beginX, &beginP, &beginR, 
+                                           &newBeginX, &newBeginP, &newBeginR);
+
+        // recursively compute maximal cliques containing vertex, some of its
+        // later neighbors, and avoiding earlier neighbors
+        listAllMaximalCliquesAdjacencyListRecursive(&cliqueCount,
+                                                    partialClique, 
+                                                    vertexSets, vertexLookup,
+                                                    newBeginX, newBeginP, newBeginR,
+                                                    pStatistics); 
+
+        #ifdef PRINT_CLIQUES_TOMITA_STYLE
+        printf("b ");
+        #endif
+
+        beginR = beginR + 1;
+
+        partialClique.pop_back();
+    }
+
+    if (pStatistics) MergeStatistics(statistics);
+
+    Free(vertexSets);
+    Free(vertexLookup);
+
+    return cliqueCount;
+}
@@ -0,0 +1,61 @@
+#ifndef _DJS_HYBRID_ALGORITHM_H_
+#define _DJS_HYBRID_ALGORITHM_H_
+
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "AdjacencyListAlgorithm.h"
+
+// system includes
+#include <list>
+#include <vector>
+
+/*! \file HybridAlgorithm.h
+
+    \brief see HybridAlgorithm.cpp
+
+    \author Darren Strash (first name DOT last name AT gmail DOT com)
+
+    \copyright Copyright (c) 2011 Darren Strash. This code is released under the GNU Public License (GPL) 3.0.
+
+    \image html gplv3-127x51.png
+
+    \htmlonly
+    <center>
+    <a href="gpl-3.0-standalone.html">See GPL 3.0 here</a>
+    </center>
+    \endhtmlonly
+*/
+
+class HybridAlgorithm : public AdjacencyListAlgorithm
+{
+public:
+    HybridAlgorithm(std::vector<std::list<int>> &&adjacencyList);
+    virtual ~HybridAlgorithm();
+
+    virtual long Run(std::list<std::list<int>> &cliques);
+
+    HybridAlgorithm           (HybridAlgorithm const &) = delete;
+    HybridAlgorithm& operator=(HybridAlgorithm const &) = delete;
+
+    long listAllMaximalCliquesHybrid();
+
+private:
+    std::vector<int> m_vOrdering;
+    int* m_EarlierDegree;
+};
+
+#endif
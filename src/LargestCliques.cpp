@@ -0,0 +1,76 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "LargestCliques.h"
+
+// system includes
+#include <algorithm>
+
+using namespace std;
+
+/*! \file LargestCliques.cpp
+
+    \brief The K largest of a stream of cliques, kept in a min-heap by size.
+
+    The size of the smallest clique in a full heap is a lower bound that
+    grows as the stream goes on: a search node whose partial clique R and
+    candidates P have at most that many vertices together cannot lead to a
+    clique that enters the heap, so an enumeration that is told the
+    threshold (see CliqueGenerator::SetSizeThreshold) prunes the node.
+*/
+
+LargestCliques::LargestCliques(int const K)
+ : m_iK(K)
+ , m_vHeap()
+{
+    m_vHeap.reserve(max(K, 0));
+}
+
+bool LargestCliques::IsLarger(vector<int> const &left, vector<int> const &right)
+{
+    return left.size() > right.size();
+}
+
+/*! \brief offer a clique; it replaces the smallest clique of a full heap
+           if it is strictly larger, so ties keep the earlier clique.
+
+    \return true if the clique was kept.
+*/
+
+bool LargestCliques::Offer(int const *begin, int const *end)
+{
+    size_t const size(end - begin);
+    if (m_iK <= 0) return false;
+    if (static_cast<int>(m_vHeap.size()) == m_iK) {
+        if (size <= m_vHeap.front().size()) return false;
+        pop_heap(m_vHeap.begin(), m_vHeap.end(), IsLarger);
+        m_vHeap.back().assign(begin, end);
+    } else {
+        m_vHeap.emplace_back(begin, end);
+    }
+    push_heap(m_vHeap.begin(), m_vHeap.end(), IsLarger);
+    return true;
+}
+
+/*! \brief the kept cliques, from largest to smallest.
+*/
+
+vector<vector<int>> LargestCliques::GetCliques() const
+{
+    vector<vector<int>> cliques(m_vHeap);
+    stable_sort(cliques.begin(), cliques.end(), IsLarger);
+    return cliques;
+}
@@ -0,0 +1,49 @@
+#ifndef LARGEST_CLIQUES_H
+#define LARGEST_CLIQUES_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <cstddef>
+#include <vector>
+
+/*! \file LargestCliques.h
+
+    \brief see LargestCliques.cpp
+*/
+
+class LargestCliques
+{
+public:
+    LargestCliques(int const K);
+
+    bool Offer(int const *begin, int const *end);
+
+    /*! \brief no clique of at most this many vertices can enter the K
+               largest; 0 until K cliques were offered.
+    */
+    size_t GetThreshold() const { return (static_cast<int>(m_vHeap.size()) < m_iK) ? 0 : m_vHeap.front().size(); }
+
+    std::vector<std::vector<int>> GetCliques() const;
+
+private:
+    static bool IsLarger(std::vector<int> const &left, std::vector<int> const &right);
+
+    int m_iK;
+    std::vector<std::vector<int>> m_vHeap; //!< a min-heap by size
+};
+
+#endif //LARGEST_CLIQUES_H
@@ -0,0 +1,273 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "RootCostModel.h"
+
+// system includes
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+using namespace std;
+
+/*! \file RootCostModel.cpp
+
+    \brief Predict the work of each root of the degeneracy algorithm before
+           enumerating, so that roots can be split into balanced shards, or
+           scheduled longest-first.
+
+    The number of later neighbors of a root alone is a poor predictor: a
+    root whose later neighbors are sparse, or form one big clique, is
+    cheap, while one whose later neighbors have middling density may have
+    exponentially many maximal cliques. So the model estimates the edge
+    density of P, the later neighbors of the root, by counting the
+    neighbors in P of up to NUM_SAMPLES of its vertices, and predicts the
+    work of the root as that of filling in P and X plus the expected number
+    of maximal cliques of a random graph with the size and density of P.
+
+    With --stats, the predictions are compared with the time spent on
+    each root.
+
+    qc uses the predictions to balance the shards of --shard. It does not
+    run roots longest-first: the enumeration visits roots in increasing
+    order of vertex id, since a checkpoint records the next root and
+    --roots a range of roots, both of which assume that order. GetRootsLongestFirst is only
+    used to compare the predicted and actual orders, and is meant for a
+    scheduler that runs roots out of order.
+*/
+
+RootCostModel::RootCostModel(NeighborListArray** orderingArray, int const size)
+ : m_pOrderingArray(orderingArray)
+ , m_iNumVertices(size)
+{
+}
+
+/*! \brief the predicted work of a search with sets P and X, where P has the
+           given edge density.
+
+    In a random graph on p vertices with edge probability d, a set of k
+    vertices is a maximal clique with probability
+    d^(k choose 2) * (1 - d^k)^(p - k), so the expected number of maximal
+    cliques is the sum of these over all k-subsets. Each maximal clique
+    costs about p to find, and filling in P and X costs about p * (p + x).
+*/
+
+double RootCostModel::EstimateSearchCost(int const sizeOfP, int const sizeOfX, double const density)
+{
+    double const p(sizeOfP);
+    double const fillIn(p * (p + sizeOfX) + 1.0);
+    if (sizeOfP == 0 || density <= 0.0) return fillIn + p;
+
+    // sum the terms in log space, as they overflow for large, dense P
+    double const logDensity(log(min(density, 1.0)));
+    double logMax(-HUGE_VAL);
+    vector<double> logTerms;
+    logTerms.reserve(sizeOfP + 1);
+    double logChoose(0.0); // log (p choose k)
+    for (int k = 1; k <= sizeOfP; ++k) {
+        logChoose += log(static_cast<double>(sizeOfP - k + 1) / k);
+        double const logInClique(0.5 * k * (k - 1) * logDensity);
+        double const probabilityExtendable(exp(k * logDensity));
+        double logMaximal(0.0);
+        if (k < sizeOfP) {
+            if (probabilityExtendable >= 1.0) continue;
+            logMaximal = (sizeOfP - k) * log1p(-probabilityExtendable);
+        }
+        double const logTerm(logChoose + logInClique + logMaximal);
+        logTerms.push_back(logTerm);
+        logMax = max(logMax, logTerm);
+    }
+
+    double sum(0.0);
+    for (double const logTerm : logTerms) {
+        sum += exp(logTerm - logMax);
+    }
+
+    // cap the estimate; roots beyond it are hopeless anyway
+    double const logCliques(min(logMax + log(sum), 600.0));
+    return fillIn + p * exp(logCliques);
+}
+
+/*! \brief predict the work of each root.
+
+    \return the predicted work of each root, in root order, in arbitrary units.
+*/
+
+vector<double> RootCostModel::Estimate() const
+{
+    vector<double> costs(m_iNumVertices, 0.0);
+
+    // inP[v] == root + 1 if v is a later neighbor of root
+    vector<int> inP(m_iNumVertices, 0);
+
+    for (int root = 0; root < m_iNumVertices; ++root) {
+        NeighborListArray const *pRoot(m_pOrderingArray[root]);
+        int const sizeOfP(pRoot->laterDegree);
+
+        double density(0.0);
+        if (sizeOfP > 1) {
+            for (int j = 0; j < sizeOfP; ++j) {
+                inP[pRoot->later[j]] = root + 1;
+            }
+
+            // count the neighbors in P of evenly spaced vertices of P
+            int const stride(max(1, sizeOfP/NUM_SAMPLES));
+            long neighborsInP(0);
+            long possibleNeighbors(0);
+            for (int j = 0; j < sizeOfP; j += stride) {
+                NeighborListArray const *pVertex(m_pOrderingArray[pRoot->later[j]]);
+                for (int k = 0; k < pVertex->earlierDegree; ++k) {
+                    if (inP[pVertex->earlier[k]] == root + 1) neighborsInP++;
+                }
+                for (int k = 0; k < pVertex->laterDegree; ++k) {
+                    if (inP[pVertex->later[k]] == root + 1) neighborsInP++;
+                }
+                possibleNeighbors += sizeOfP - 1;
+            }
+            density = static_cast<double>(neighborsInP)/possibleNeighbors;
+        }
+
+        costs[root] = EstimateSearchCost(sizeOfP, pRoot->earlierDegree, density);
+    }
+
+    return costs;
+}
+
+/*! \brief the roots, ordered from the largest to the smallest cost, e.g.,
+           for a scheduler that hands out the longest roots first.
+*/
+
+vector<int> RootCostModel::GetRootsLongestFirst(vector<double> const &costs)
+{
+    vector<int> roots(costs.size());
+    for (size_t root = 0; root < costs.size(); ++root) {
+        roots[root] = root;
+    }
+    stable_sort(roots.begin(), roots.end(), [&costs](int const a, int const b) { return costs[a] > costs[b]; });
+    return roots;
+}
+
+namespace
+{
+    //! the rank of each value, with ties given their average rank
+    vector<double> GetRanks(vector<double> const &values)
+    {
+        vector<int> order(values.size());
+        for (size_t i = 0; i < values.size(); ++i) order[i] = i;
+        sort(order.begin(), order.end(), [&values](int const a, int const b) { return values[a] < values[b]; });
+
+        vector<double> ranks(values.size(), 0.0);
+        size_t begin(0);
+        while (begin < order.size()) {
+            size_t end(begin + 1);
+            while (end < order.size() && values[order[end]] == values[order[begin]]) end++;
+            double const rank(0.5 * (begin + end - 1));
+            for (size_t i = begin; i < end; ++i) ranks[order[i]] = rank;
+            begin = end;
+        }
+        return ranks;
+    }
+
+    double GetCorrelation(vector<double> const &x, vector<double> const &y)
+    {
+        size_t const n(x.size());
+        if (n < 2) return 0.0;
+        double meanX(0.0), meanY(0.0);
+        for (size_t i = 0; i < n; ++i) {
+            meanX += x[i];
+            meanY += y[i];
+        }
+        meanX /= n;
+        meanY /= n;
+        double covariance(0.0), varianceX(0.0), varianceY(0.0);
+        for (size_t i = 0; i < n; ++i) {
+            covariance += (x[i] - meanX) * (y[i] - meanY);
+            varianceX  += (x[i] - meanX) * (x[i] - meanX);
+            varianceY  += (y[i] - meanY) * (y[i] - meanY);
+        }
+        if (varianceX <= 0.0 || varianceY <= 0.0) return 0.0;
+        return covariance / sqrt(varianceX * varianceY);
+    }
+};
+
+/*! \brief print how well the predicted costs match the work of the roots
+           that were searched: the rank correlation of predictions and
+           times, the share of the time spent on the roots predicted to be
+           the most expensive, and the roots predicted to be the most
+           expensive, longest first.
+*/
+
+void RootCostModel::PrintComparison(ostream &out, vector<double> const &predicted,
+                                    vector<double> const &actualSeconds, vector<unsigned long> const &actualNodes)
+{
+    // only roots that were searched have a recorded number of nodes
+    vector<int> roots;
+    vector<double> searchedPredicted, searchedSeconds;
+    double totalSeconds(0.0);
+    for (size_t root = 0; root < predicted.size() && root < actualNodes.size(); ++root) {
+        if (actualNodes[root] == 0) continue;
+        roots.push_back(root);
+        searchedPredicted.push_back(predicted[root]);
+        searchedSeconds.push_back(actualSeconds[root]);
+        totalSeconds += actualSeconds[root];
+    }
+
+    out << "Roots searched           : " << roots.size() << endl;
+    if (roots.empty()) return;
+
+    out << "Rank correlation         : " << fixed << setprecision(3)
+        << GetCorrelation(GetRanks(searchedPredicted), GetRanks(searchedSeconds)) << endl;
+
+    // the share of the time spent on the top 1% of roots, as predicted,
+    // and at best
+    size_t const numTop(max<size_t>(1, roots.size()/100));
+    vector<int> const predictedOrder(GetRootsLongestFirst(searchedPredicted));
+    vector<int> const actualOrder(GetRootsLongestFirst(searchedSeconds));
+    double predictedTopSeconds(0.0), actualTopSeconds(0.0);
+    for (size_t i = 0; i < numTop; ++i) {
+        predictedTopSeconds += searchedSeconds[predictedOrder[i]];
+        actualTopSeconds    += searchedSeconds[actualOrder[i]];
+    }
+    if (totalSeconds > 0.0) {
+        out << "Time in top 1% predicted : " << setprecision(1) << 100.0 * predictedTopSeconds / totalSeconds << "%"
+            << " (top 1% actual: " << 100.0 * actualTopSeconds / totalSeconds << "%)" << endl;
+    }
+
+    out << "Most expensive roots, as predicted:" << endl;
+    out << "  " << setw(8) << "root" << setw(14) << "predicted" << setw(14) << "seconds" << setw(14) << "nodes" << endl;
+    for (size_t i = 0; i < min<size_t>(10, roots.size()); ++i) {
+        int const root(roots[predictedOrder[i]]);
+        out << "  " << setw(8) << root << setw(14) << scientific << setprecision(3) << predicted[root]
+            << setw(14) << fixed << setprecision(6) << actualSeconds[root] << setw(14) << actualNodes[root] << endl;
+    }
+    out.unsetf(ios::floatfield);
+    out << setprecision(6) << flush;
+}
+
+/*! \brief write the predicted cost, the time, and the number of search
+           nodes of each root that was searched, as tab-separated values.
+*/
+
+void RootCostModel::WriteComparison(ostream &out, vector<double> const &predicted,
+                                    vector<double> const &actualSeconds, vector<unsigned long> const &actualNodes)
+{
+    out << "root\tpredicted\tseconds\tnodes" << endl;
+    for (size_t root = 0; root < predicted.size() && root < actualNodes.size(); ++root) {
+        if (actualNodes[root] == 0) continue;
+        out << root << "\t" << predicted[root] << "\t" << actualSeconds[root] << "\t" << actualNodes[root] << endl;
+    }
+    out << flush;
+}
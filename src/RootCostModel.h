@@ -0,0 +1,55 @@
+#ifndef ROOT_COST_MODEL_H
+#define ROOT_COST_MODEL_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "DegeneracyTools.h"
+
+// system includes
+#include <vector>
+#include <ostream>
+
+/*! \file RootCostModel.h
+
+    \brief see RootCostModel.cpp
+*/
+
+class RootCostModel
+{
+public:
+    //! the number of vertices of P whose neighbors in P are counted, per root
+    static int const NUM_SAMPLES = 32;
+
+    RootCostModel(NeighborListArray** orderingArray, int const size);
+
+    std::vector<double> Estimate() const;
+
+    static double EstimateSearchCost(int const sizeOfP, int const sizeOfX, double const density);
+
+    static std::vector<int> GetRootsLongestFirst(std::vector<double> const &costs);
+
+    static void PrintComparison(std::ostream &out, std::vector<double> const &predicted,
+                                std::vector<double> const &actualSeconds, std::vector<unsigned long> const &actualNodes);
+    static void WriteComparison(std::ostream &out, std::vector<double> const &predicted,
+                                std::vector<double> const &actualSeconds, std::vector<unsigned long> const &actualNodes);
+
+private:
+    NeighborListArray** m_pOrderingArray;
+    int m_iNumVertices;
+};
+
+#endif //ROOT_COST_MODEL_H
@@ -0,0 +1,299 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "RunReport.h"
+
+// system includes
+#include <sys/resource.h>
+#include <cassert>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+/*! \file RunReport.cpp
+
+    \brief Collects wall-clock time per phase of a run (parsing, ordering,
+           enumeration, top-k selection, and output), along with clique
+           counts and the peak resident set size, and prints them as
+           plain text, a table row, a LaTeX table row, or JSON.
+
+    Times are measured with std::chrono::steady_clock, so they remain
+    meaningful when work is done in parallel (unlike clock(), which
+    reports CPU time summed over all threads).
+*/
+
+namespace
+{
+    string JsonEscape(string const &value)
+    {
+        string escaped;
+        for (char const c : value) {
+            if (c == '"' || c == '\\') {
+                escaped.push_back('\\');
+                escaped.push_back(c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                escaped += buffer;
+            } else {
+                escaped.push_back(c);
+            }
+        }
+        return escaped;
+    }
+
+    //! a name as LaTeX text; graph names often have underscores
+    string LatexEscape(string const &value)
+    {
+        string escaped;
+        for (char const c : value) {
+            if (c == '_' || c == '&' || c == '%' || c == '#' || c == '$' || c == '{' || c == '}') {
+                escaped.push_back('\\');
+            }
+            escaped.push_back(c);
+        }
+        return escaped;
+    }
+
+    string Seconds(double const seconds)
+    {
+        stringstream strm;
+        strm.precision(6);
+        strm.setf(std::ios::fixed, std::ios::floatfield);
+        strm << seconds;
+        return strm.str();
+    }
+};
+
+RunReport::RunReport()
+ : m_sGraphName()
+ , m_sAlgorithmName()
+ , m_lNumVertices(0)
+ , m_lNumEdges(0)
+ , m_lCliqueCount(0)
+ , m_bSizePruned(false)
+ , m_vCounts()
+ , m_Created(Clock::now())
+{
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        m_vPhaseStart[phase]   = Clock::time_point();
+        m_vPhaseElapsed[phase] = Clock::duration::zero();
+    }
+}
+
+char const *RunReport::GetPhaseName(Phase const phase)
+{
+    switch (phase) {
+        case PHASE_PARSE:       return "parse";
+        case PHASE_ORDERING:    return "ordering";
+        case PHASE_ENUMERATION: return "enumeration";
+        case PHASE_SELECTION:   return "selection";
+        case PHASE_OUTPUT:      return "output";
+        default: break;
+    }
+    assert(false);
+    return "";
+}
+
+/*! \brief start timing a phase. A phase may be started and stopped
+           several times; its elapsed times are summed.
+*/
+
+void RunReport::StartPhase(Phase const phase)
+{
+    m_vPhaseStart[phase] = Clock::now();
+}
+
+void RunReport::StopPhase(Phase const phase)
+{
+    m_vPhaseElapsed[phase] += Clock::now() - m_vPhaseStart[phase];
+}
+
+double RunReport::GetPhaseSeconds(Phase const phase) const
+{
+    return chrono::duration<double>(m_vPhaseElapsed[phase]).count();
+}
+
+double RunReport::GetTotalSeconds() const
+{
+    return chrono::duration<double>(Clock::now() - m_Created).count();
+}
+
+void RunReport::SetGraphName(string const &name)
+{
+    m_sGraphName = name;
+}
+
+void RunReport::SetAlgorithmName(string const &name)
+{
+    m_sAlgorithmName = name;
+}
+
+void RunReport::SetNumVertices(long const numVertices)
+{
+    m_lNumVertices = numVertices;
+}
+
+void RunReport::SetNumEdges(long const numEdges)
+{
+    m_lNumEdges = numEdges;
+}
+
+void RunReport::SetCliqueCount(long const cliqueCount)
+{
+    m_lCliqueCount = cliqueCount;
+}
+
+/*! \brief record that the enumeration skipped cliques too small to be
+           chosen (e.g., for --objective=largest), so the clique count is
+           of the cliques offered, not of all maximal cliques, and is
+           labeled as such.
+*/
+
+void RunReport::SetSizePruned(bool const sizePruned)
+{
+    m_bSizePruned = sizePruned;
+}
+
+/*! \brief record an additional named count (e.g., K, or the value of the
+           best solution), printed after the standard columns.
+*/
+
+void RunReport::SetCount(string const &name, long const value)
+{
+    for (pair<string, long> &count : m_vCounts) {
+        if (count.first == name) {
+            count.second = value;
+            return;
+        }
+    }
+    m_vCounts.push_back(make_pair(name, value));
+}
+
+long RunReport::GetCliqueCount() const
+{
+    return m_lCliqueCount;
+}
+
+double RunReport::GetCliquesPerSecond() const
+{
+    double const seconds(GetPhaseSeconds(PHASE_ENUMERATION));
+    if (seconds <= 0.0) return 0.0;
+    return m_lCliqueCount/seconds;
+}
+
+/*! \brief the peak resident set size of this process so far, in kilobytes.
+*/
+
+long RunReport::GetPeakResidentSetKB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss/1024; // reported in bytes
+#else
+    return usage.ru_maxrss;      // reported in kilobytes
+#endif
+}
+
+void RunReport::PrintText(ostream &out) const
+{
+    out << "Graph            : " << m_sGraphName << " (" << m_lNumVertices << " vertices, " << m_lNumEdges << " edges)" << endl;
+    out << "Algorithm        : " << m_sAlgorithmName << endl;
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        out << "Time " << left << setw(12) << GetPhaseName(static_cast<Phase>(phase)) << ": " << Seconds(GetPhaseSeconds(static_cast<Phase>(phase))) << "s" << endl;
+    }
+    out << "Time total       : " << Seconds(GetTotalSeconds()) << "s" << endl;
+    if (m_bSizePruned) {
+        out << "Cliques offered  : " << m_lCliqueCount << " (the enumeration skipped cliques too small to be chosen)" << endl;
+    } else {
+        out << "Maximal cliques  : " << m_lCliqueCount << endl;
+    }
+    out << "Cliques/second   : " << static_cast<long>(GetCliquesPerSecond()) << endl;
+    out << "Peak RSS         : " << GetPeakResidentSetKB() << " KB" << endl;
+    for (pair<string, long> const &count : m_vCounts) {
+        out << left << setw(17) << count.first << ": " << count.second << endl;
+    }
+    out << right << flush;
+}
+
+void RunReport::PrintTable(ostream &out, bool const header) const
+{
+    if (header) {
+        out << "graph\talgorithm\tvertices\tedges\t" << (m_bSizePruned ? "cliques_offered" : "cliques");
+        for (int phase = 0; phase < NUM_PHASES; ++phase) {
+            out << "\t" << GetPhaseName(static_cast<Phase>(phase));
+        }
+        out << "\ttotal\tcliques_per_second\tpeak_rss_kb";
+        for (pair<string, long> const &count : m_vCounts) {
+            out << "\t" << count.first;
+        }
+        out << endl;
+    }
+
+    out << m_sGraphName << "\t" << m_sAlgorithmName << "\t" << m_lNumVertices << "\t" << m_lNumEdges << "\t" << m_lCliqueCount;
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        out << "\t" << Seconds(GetPhaseSeconds(static_cast<Phase>(phase)));
+    }
+    out << "\t" << Seconds(GetTotalSeconds()) << "\t" << static_cast<long>(GetCliquesPerSecond()) << "\t" << GetPeakResidentSetKB();
+    for (pair<string, long> const &count : m_vCounts) {
+        out << "\t" << count.second;
+    }
+    out << endl << flush;
+}
+
+void RunReport::PrintLatex(ostream &out) const
+{
+    stringstream strm;
+    strm.precision(2);
+    strm.setf(std::ios::fixed, std::ios::floatfield);
+
+    strm << LatexEscape(m_sGraphName) << " & " << m_lNumVertices << " & " << m_lNumEdges << " & " << m_lCliqueCount;
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        strm << " & " << GetPhaseSeconds(static_cast<Phase>(phase));
+    }
+    strm << " & " << GetTotalSeconds() << " & " << static_cast<long>(GetCliquesPerSecond()) << " & " << GetPeakResidentSetKB();
+    for (pair<string, long> const &count : m_vCounts) {
+        strm << " & " << count.second;
+    }
+    strm << " \\\\";
+    out << strm.str() << endl << flush;
+}
+
+void RunReport::PrintJson(ostream &out) const
+{
+    out << "{";
+    out << "\"graph\": \"" << JsonEscape(m_sGraphName) << "\", ";
+    out << "\"algorithm\": \"" << JsonEscape(m_sAlgorithmName) << "\", ";
+    out << "\"vertices\": " << m_lNumVertices << ", ";
+    out << "\"edges\": " << m_lNumEdges << ", ";
+    out << "\"" << (m_bSizePruned ? "cliques_offered" : "cliques") << "\": " << m_lCliqueCount << ", ";
+    out << "\"phases\": {";
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        if (phase != 0) out << ", ";
+        out << "\"" << GetPhaseName(static_cast<Phase>(phase)) << "\": " << Seconds(GetPhaseSeconds(static_cast<Phase>(phase)));
+    }
+    out << "}, ";
+    out << "\"total_seconds\": " << Seconds(GetTotalSeconds()) << ", ";
+    out << "\"cliques_per_second\": " << Seconds(GetCliquesPerSecond()) << ", ";
+    out << "\"peak_rss_kb\": " << GetPeakResidentSetKB();
+    for (pair<string, long> const &count : m_vCounts) {
+        out << ", \"" << JsonEscape(count.first) << "\": " << count.second;
+    }
+    out << "}" << endl << flush;
+}
@@ -0,0 +1,87 @@
+#ifndef RUN_REPORT_H
+#define RUN_REPORT_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+
+/*! \file RunReport.h
+
+    \brief see RunReport.cpp
+*/
+
+class RunReport
+{
+public:
+    enum Phase
+    {
+        PHASE_PARSE = 0,
+        PHASE_ORDERING,
+        PHASE_ENUMERATION,
+        PHASE_SELECTION,
+        PHASE_OUTPUT,
+        NUM_PHASES
+    };
+
+    RunReport();
+
+    void StartPhase(Phase const phase);
+    void StopPhase(Phase const phase);
+    double GetPhaseSeconds(Phase const phase) const;
+    double GetTotalSeconds() const;
+
+    void SetGraphName(std::string const &name);
+    void SetAlgorithmName(std::string const &name);
+    void SetNumVertices(long const numVertices);
+    void SetNumEdges(long const numEdges);
+    void SetCliqueCount(long const cliqueCount);
+    void SetSizePruned(bool const sizePruned);
+    void SetCount(std::string const &name, long const value);
+
+    long GetCliqueCount() const;
+    double GetCliquesPerSecond() const;
+
+    static long GetPeakResidentSetKB();
+
+    void PrintText (std::ostream &out) const;
+    void PrintTable(std::ostream &out, bool const header) const;
+    void PrintLatex(std::ostream &out) const;
+    void PrintJson (std::ostream &out) const;
+
+    static char const *GetPhaseName(Phase const phase);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    std::string m_sGraphName;
+    std::string m_sAlgorithmName;
+    long m_lNumVertices;
+    long m_lNumEdges;
+    long m_lCliqueCount;
+    bool m_bSizePruned; //!< the count is of the cliques offered by a size-pruned enumeration
+    std::vector<std::pair<std::string, long>> m_vCounts;
+
+    Clock::time_point m_Created;
+    Clock::time_point m_vPhaseStart[NUM_PHASES];
+    Clock::duration   m_vPhaseElapsed[NUM_PHASES];
+};
+
+#endif //RUN_REPORT_H
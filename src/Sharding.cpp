@@ -0,0 +1,107 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "Sharding.h"
+
+// system includes
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+/*! \file Sharding.cpp
+
+    \brief Split an enumeration into ranges of roots, which are vertex ids
+           (not positions in the degeneracy order), so that one graph
+           can be spread over several processes or machines that share
+           nothing. The search trees of the roots are disjoint, so the
+           shards list disjoint sets of cliques, which bin/qc-merge
+           combines.
+*/
+
+/*! \brief the range of roots of one of numShards shards, such that all
+           shards have about the same total estimated cost.
+
+    \param costs the estimated cost of each root, indexed by vertex id.
+
+    \param shard the shard, in [0, numShards).
+
+    \param numShards the number of shards.
+
+    \param beginRoot on return, the first root of the shard.
+
+    \param endRoot on return, one past the last root of the shard.
+*/
+
+void Sharding::GetBalancedRange(vector<double> const &costs, int const shard, int const numShards, int &beginRoot, int &endRoot)
+{
+    // prefix[j] is the cost of roots [0, j)
+    vector<double> prefix(costs.size() + 1, 0.0);
+    for (size_t i = 0; i < costs.size(); ++i) {
+        prefix[i + 1] = prefix[i] + costs[i];
+    }
+
+    // a shard starts at the first root whose earlier roots cost at least
+    // its share of the total
+    double const total(prefix.back());
+    auto const getBoundary = [&prefix, total, numShards](int const index) {
+        if (index <= 0) return 0;
+        if (index >= numShards) return static_cast<int>(prefix.size()) - 1;
+        double const target(total * index / numShards);
+        return static_cast<int>(lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin());
+    };
+
+    beginRoot = getBoundary(shard);
+    endRoot   = getBoundary(shard + 1);
+}
+
+/*! \brief parse a range of roots given as BEGIN:END.
+
+    \return true if value is a valid range.
+*/
+
+bool Sharding::ParseRootRange(string const &value, int &beginRoot, int &endRoot)
+{
+    size_t const positionOfColon(value.find(':'));
+    if (positionOfColon == string::npos || positionOfColon == 0) return false;
+
+    char *end(nullptr);
+    beginRoot = static_cast<int>(strtol(value.c_str(), &end, 10));
+    if (end != value.c_str() + positionOfColon) return false;
+    endRoot = static_cast<int>(strtol(value.c_str() + positionOfColon + 1, &end, 10));
+    if (*end != '\0' || positionOfColon + 1 == value.size()) return false;
+
+    return 0 <= beginRoot && beginRoot <= endRoot;
+}
+
+/*! \brief parse a shard given as i/N, with i in [0, N).
+
+    \return true if value is a valid shard.
+*/
+
+bool Sharding::ParseShard(string const &value, int &shard, int &numShards)
+{
+    size_t const positionOfSlash(value.find('/'));
+    if (positionOfSlash == string::npos || positionOfSlash == 0) return false;
+
+    char *end(nullptr);
+    shard = static_cast<int>(strtol(value.c_str(), &end, 10));
+    if (end != value.c_str() + positionOfSlash) return false;
+    numShards = static_cast<int>(strtol(value.c_str() + positionOfSlash + 1, &end, 10));
+    if (*end != '\0' || positionOfSlash + 1 == value.size()) return false;
+
+    return 0 <= shard && shard < numShards;
+}
@@ -0,0 +1,36 @@
+#ifndef SHARDING_H
+#define SHARDING_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <string>
+#include <vector>
+
+/*! \file Sharding.h
+
+    \brief see Sharding.cpp
+*/
+
+namespace Sharding
+{
+    void GetBalancedRange(std::vector<double> const &costs, int const shard, int const numShards, int &beginRoot, int &endRoot);
+
+    bool ParseRootRange(std::string const &value, int &beginRoot, int &endRoot);
+    bool ParseShard(std::string const &value, int &shard, int &numShards);
+};
+
+#endif //SHARDING_H
@@ -0,0 +1,474 @@
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "TomitaAlgorithm.h"
+#include "Tools.h"
+#include "MemoryManager.h"
+
+// system includes
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <vector>
+
+using namespace std;
+
+/*! \file TomitaAlgorithm.cpp
+
+    \brief This file contains the algorithm for listing all maximal cliques
+           according to the algorithm of Tomita et al. (TCS 2006), using
+           an adjacency matrix.
+
+    \author Darren Strash (first name DOT last name AT gmail DOT com)
+
+    \copyright Copyright (c) 2011 Darren Strash. This code is released under the GNU Public License (GPL) 3.0.
+
+    \image html gplv3-127x51.png
+
+    \htmlonly
+    <center>
+    <a href="gpl-3.0-standalone.html">See GPL 3.0 here</a>
+    </center>
+    \endhtmlonly
+
+    See the algorithm's description in http://dx.doi.org/10.1016/j.tcs.2006.06.015
+
+    This is a recursive backtracking algorithm that maintains three 
+    sets of vertices, R, a partial clique, P, the common neighbors
+    of vertices in R that are candidates to add to the partial clique,
+    and X, the set of common neighbors of R that have been listed 
+    in a maximal clique with R already.
+
+    The sets are stored in a single array, partitioned as |--X--|--P--|--R--|,
+    and the adjacency matrix answers each adjacency query in constant
+    time. The pivot is the vertex in P union X with the most neighbors
+    in P, and only its non-neighbors in P are added to R.
+
+    The matrix takes n^2 bytes, so this algorithm is only suitable for
+    graphs with few vertices.
+*/
+
+TomitaAlgorithm::TomitaAlgorithm(vector<list<int>> &&adjacencyList)
+ : Algorithm("tomita")
+ , m_iNumVertices(adjacencyList.size())
+ , m_AdjacencyMatrix(nullptr)
+{
+    m_AdjacencyMatrix = (char**)Calloc(m_iNumVertices, sizeof(char*));
+
+    for (int i = 0; i < m_iNumVertices; i++) {
+        m_AdjacencyMatrix[i] = (char*)Calloc(m_iNumVertices, sizeof(char));
+        for (int const neighbor : adjacencyList[i]) {
+            m_AdjacencyMatrix[i][neighbor] = 1;
+        }
+
+        // the matrix is the only representation this algorithm reads
+        list<int>().swap(adjacencyList[i]);
+    }
+
+    vector<list<int>>().swap(adjacencyList);
+}
+
+TomitaAlgorithm::~TomitaAlgorithm()
+{
+    for (int i = 0; i < m_iNumVertices; i++) {
+        Free(m_AdjacencyMatrix[i]);
+    }
+
+    Free(m_AdjacencyMatrix);
+}
+
+long TomitaAlgorithm::Run(list<list<int>> &cliques)
+{
+    return listAllMaximalCliquesMatrix();
+}
+
+/*! \brief Computes the vertex v in P union X that has the most neighbors in P,
+           and places P \ {neighborhood of v} in an array. These are the 
+           vertices to consider adding to the partial clique during the current
+           recursive call of the algorithm.
+
+    \param pivotNonNeighbors  An intially unallocated pointer, which will contain the set 
+                              P \ {neighborhood of v} when this function completes.
+
+    \param numNonNeighbors A pointer to a single integer, which has been preallocated,
+                           which will contain the number of elements in pivotNonNeighbors.
+
+    \param adjacencyMatrix The input graph, as an adjacency matrix.
+ 
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R, and other.
+ 
+    \param beginX The index where set X begins in vertexSets.
+ 
+    \param beginP The index where set P begins in vertexSets.
+
+    \param beginR The index where set R begins in vertexSets.
+
+*/
+
+inline int findBestPivotNonNeighborsMatrix( int** pivotNonNeighbors, int* numNonNeighbors,
+                                            char** adjacencyMatrix,
+                                            int* vertexSets,
+                                            int beginX, int beginP, int beginR)
+{
+    int pivot = vertexSets[beginP];
+    int maxIntersectionSize = -1;
+
+    // iterate over each vertex in P union X 
+    // to find the vertex with the most neighbors in P.
+    int j = beginX;
+    while(j<beginR)
+    {
+        int vertex = vertexSets[j];
+        char* neighbors = adjacencyMatrix[vertex];
+
+        int numNeighborsInP = 0;
+
+        int k = beginP;
+        while(k<beginR)
+        {
+            numNeighborsInP += neighbors[vertexSets[k]];
+            k++;
+        }
+
+        if(numNeighborsInP > maxIntersectionSize)
+        {
+            pivot = vertex;
+            maxIntersectionSize = numNeighborsInP;
+        }
+
+        j++;
+    }
+
+    // we initialize enough space for all of P; this is
+    // slightly space inefficient, but it results in faster
+    // computation of non-neighbors.
+    *pivotNonNeighbors = (int*)Calloc(beginR-beginP, sizeof(int));
+    *numNonNeighbors = 0;
+
+    // the pivot is not its own neighbor, so it is added
+    // to the candidates if it is in P.
+    char* pivotNeighbors = adjacencyMatrix[pivot];
+    j = beginP;
+    while(j<beginR)
+    {
+        int vertex = vertexSets[j];
+        if(!pivotNeighbors[vertex])
+        {
+            (*pivotNonNeighbors)[(*numNonNeighbors)++] = vertex;
+        }
+
+        j++;
+    }
+
+    return pivot; 
+}
+
+/*! \brief Move a vertex to the set R, and update the sets P and X
+
+    \param vertex The vertex to move to R.
+
+    \param adjacencyMatrix The input graph, as an adjacency matrix.
+
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R, and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param pBeginX The index where set X begins in vertexSets.
+ 
+    \param pBeginP The index where set P begins in vertexSets.
+
+    \param pBeginR The index where set R begins in vertexSets.
+
+    \param pNewBeginX After function, contains the new index where set X begins
+                      in vertexSets after adding vertex to R.
+ 
+    \param pNewBeginP After function, contains the new index where set P begins
+                      in vertexSets after adding vertex to P.
+
+    \param pNewBeginR After function, contains the new index where set R begins
+                      in vertexSets after adding vertex to R.
+*/
+
+inline void moveToRMatrix( int vertex, 
+                           char** adjacencyMatrix,
+                           int* vertexSets, int* vertexLookup, 
+                           int* pBeginX, int *pBeginP, int *pBeginR, 
+                           int* pNewBeginX, int* pNewBeginP, int *pNewBeginR)
+{
+    int vertexLocation = vertexLookup[vertex];
+
+    (*pBeginR)--;
+    vertexSets[vertexLocation] = vertexSets[*pBeginR];
+    vertexLookup[vertexSets[*pBeginR]] = vertexLocation;
+    vertexSets[*pBeginR] = vertex;
+    vertexLookup[vertex] = *pBeginR;
+
+    // this is not a typo, initially newX is empty
+    *pNewBeginX = *pBeginP;
+    *pNewBeginP = *pBeginP;
+    *pNewBeginR = *pBeginP;
+
+    char* neighbors = adjacencyMatrix[vertex];
+
+    // swap neighbors of vertex in X to the end of X
+    int j = *pBeginX;
+    while(j<*pNewBeginX)
+    {
+        int neighbor = vertexSets[j];
+
+        if(neighbors[neighbor])
+        {
+            (*pNewBeginX)--;
+            vertexSets[j] = vertexSets[*pNewBeginX];
+            vertexLookup[vertexSets[*pNewBeginX]] = j;
+            vertexSets[*pNewBeginX] = neighbor;
+            vertexLookup[neighbor] = *pNewBeginX;
+        }
+        else
+        {
+            j++;
+        }
+    }
+
+    // swap neighbors of vertex in P to the beginning of P
+    j = *pBeginP;
+    while(j<*pBeginR)
+    {
+        int neighbor = vertexSets[j];
+
+        if(neighbors[neighbor])
+        {
+            vertexSets[j] = vertexSets[*pNewBeginR];
+            vertexLookup[vertexSets[*pNewBeginR]] = j;
+            vertexSets[*pNewBeginR] = neighbor;
+            vertexLookup[neighbor] = *pNewBeginR;
+            (*pNewBeginR)++;
+        }
+
+        j++;
+    }
+}
+
+/*! \brief Move a vertex from the set R to the set X, and update all necessary pointers
+
+    \param vertex The vertex to move from R to X.
+
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R, and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param pBeginX The index where set X begins in vertexSets.
+ 
+    \param pBeginP The index where set P begins in vertexSets.
+
+    \param pBeginR The index where set R begins in vertexSets.
+
+*/
+
+inline void moveFromRToXMatrix( int vertex, 
+                                int* vertexSets, int* vertexLookup, 
+                                int* pBeginX, int* pBeginP, int* pBeginR )
+{
+    int vertexLocation = vertexLookup[vertex];
+
+    //swap vertex into X and increment beginP and beginR
+    vertexSets[vertexLocation] = vertexSets[*pBeginP];
+    vertexLookup[vertexSets[*pBeginP]] = vertexLocation;
+    vertexSets[*pBeginP] = vertex;
+    vertexLookup[vertex] = *pBeginP;
+
+    *pBeginP = *pBeginP + 1;
+    *pBeginR = *pBeginR + 1;
+}
+
+/*! \brief List all maximal cliques in the graph using the algorithm
+           by Tomita et al. (TCS 2006), with an adjacency matrix.
+
+    \return the number of maximal cliques of the input graph.
+*/
+
+long TomitaAlgorithm::listAllMaximalCliquesMatrix()
+{
+    int const size(m_iNumVertices);
+
+    // vertex sets are stored in an array like this:
+    // |--X--|--P--|--R--|
+    int* vertexSets = (int*)Calloc(size, sizeof(int));
+
+    // vertex i is stored in vertexSets[vertexLookup[i]]
+    int* vertexLookup = (int*)Calloc(size, sizeof(int));
+
+    int i = 0;
+    while(i<size)
+    {
+        vertexLookup[i] = i;
+        vertexSets[i] = i;
+        i++;
+    }
+
+    long cliqueCount = 0;
+
+    list<int> partialClique;
+
+    // statistics are gathered locally, and published when the run completes
+    EnumerationStatistics statistics;
+    EnumerationStatistics* pStatistics = GetCollectStatistics() ? &statistics : nullptr;
+    ClearStatistics();
+    if (pStatistics) pStatistics->Start();
+
+    // initially, all vertices are in P
+    if (size > 0) {
+        listAllMaximalCliquesMatrixRecursive(&cliqueCount,
+                                             partialClique,
+                                             vertexSets, vertexLookup,
+                                             0, 0, size,
+                                             pStatistics);
+    }
+
+    if (pStatistics) MergeStatistics(statistics);
+
+    Free(vertexSets);
+    Free(vertexLookup);
+
+    return cliqueCount;
+}
+
+/*! \brief Recursively list all maximal cliques containing all of
+           all vertices in R, some vertices in P and no vertices in X.
+
+    \param cliqueCount A pointer to the number of maximal cliques computed 
+                       thus far.
+
+    \param partialClique A linked list storing R, the partial clique for this
+                         recursive call. 
+
+    \param vertexSets An array containing sets of vertices divided into sets X, P, R and other.
+ 
+    \param vertexLookup A lookup table indexed by vertex number, storing the index of that 
+                        vertex in vertexSets.
+
+    \param beginX The index where set X begins in vertexSets.
+ 
+    \param beginP The index where set P begins in vertexSets.
+
+    \param beginR The index where set R begins in vertexSets.
+
+    \param pStatistics If non-null, delay statistics for this run are recorded here.
+
+*/
+
+void TomitaAlgorithm::listAllMaximalCliquesMatrixRecursive(long* cliqueCount,
+                                                          list<int> &partialClique,
+                                                          int* vertexSets, int* vertexLookup,
+                                                          int beginX, int beginP, int beginR,
+                                                          EnumerationStatistics* pStatistics)
+{
+    if (pStatistics) pStatistics->RecordNode(partialClique.size());
+
+    // if X is empty and P is empty, process partial clique as maximal
+    if(beginX >= beginP && beginP >= beginR)
+    {
+        (*cliqueCount)++;
+
+        if (pStatistics) pStatistics->RecordClique(partialClique.size());
+
+        ExecuteCallBacks(partialClique);
+        processClique(partialClique);
+
+        return;
+    }
+
+    // avoid work if P is empty.
+    if(beginP >= beginR)
+        return;
+
+    int* myCandidatesToIterateThrough;
+    int numCandidatesToIterateThrough;
+
+    // get the candidates to add to R to make a maximal clique
+    findBestPivotNonNeighborsMatrix( &myCandidatesToIterateThrough,
+                                     &numCandidatesToIterateThrough,
+                                     m_AdjacencyMatrix,
+                                     vertexSets,
+                                     beginX, beginP, beginR);
+
+    // add candiate vertices to the partial clique one at a time and 
+    // search for maximal cliques
+    int iterator = 0;
+    while(iterator < numCandidatesToIterateThrough)
+    {
+        // vertex to be added to the partial clique
+        int vertex = myCandidatesToIterateThrough[iterator];
+
+        #ifdef PRINT_CLIQUES_TOMITA_STYLE
+        printf("%d ", vertex);
+        #endif
+
+        int newBeginX, newBeginP, newBeginR;
+
+        // add vertex into partialClique, representing R.
+        partialClique.push_back(vertex);
+
+        // swap vertex into R and update all data structures 
+        moveToRMatrix( vertex, 
+                       m_AdjacencyMatrix,
+                       vertexSets, vertexLookup, 
+                       &beginX, &beginP, &beginR, 
+                       &newBeginX, &newBeginP, &newBeginR);
+
+        // recursively compute maximal cliques with new sets R, P and X
+        listAllMaximalCliquesMatrixRecursive(cliqueCount,
+                                             partialClique,
+                                             vertexSets, vertexLookup,
+                                             newBeginX, newBeginP, newBeginR,
+                                             pStatistics);
+
+        #ifdef PRINT_CLIQUES_TOMITA_STYLE
+        printf("b ");
+        #endif
+
+        // remove vertex from partialClique
+        partialClique.pop_back();
+
+        moveFromRToXMatrix( vertex, 
+                            vertexSets, vertexLookup,
+                            &beginX, &beginP, &beginR );
+
+        iterator++;
+    }
+
+    // swap vertices that were moved to X back into P, for higher recursive calls.
+    iterator = 0;
+    while(iterator < numCandidatesToIterateThrough)
+    {
+        int vertex = myCandidatesToIterateThrough[iterator];
+        int vertexLocation = vertexLookup[vertex];
+
+        beginP--;
+        vertexSets[vertexLocation] = vertexSets[beginP];
+        vertexSets[beginP] = vertex;
+        vertexLookup[vertex] = beginP;
+        vertexLookup[vertexSets[vertexLocation]] = vertexLocation;
+
+        iterator++;
+    }
+
+    Free(myCandidatesToIterateThrough);
+}
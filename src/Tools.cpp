@@ -24,6 +24,7 @@
 #include <set>
 #include <vector>
 #include <string>
+#include <map>
 #include <iostream>
 #include <sstream>
 #include "MemoryManager.h"
@@ -652,6 +653,35 @@ string Tools::GetTimeInSeconds(clock_t delta, bool const brackets) {
     return strm.str();
 }
 
+/*! \brief whether a file is in the METIS format, which is detected by the .graph extension.
+*/
+
+bool Tools::IsMetisFile(string const &fileName)
+{
+    return fileName.find(".graph") != string::npos;
+}
+
+/*! \brief read a graph in the METIS format (.graph extension), or
+           in the custom one edge per line format otherwise.
+
+    \param fileName the file to read.
+
+    \param n this will be the number of vertices in the graph when this function returns.
+
+    \param m this will be the number of edges (METIS format) or 2x the number of edges
+             (custom format) given in the file header when this function returns.
+
+    \return an adjacency list representation of the graph, with zero-based vertex ids.
+*/
+
+vector<list<int>> Tools::ReadGraph(string const &fileName, int &n, int &m)
+{
+    if (IsMetisFile(fileName)) {
+        return readInGraphAdjListEdgesPerLine(n, m, fileName);
+    }
+    return readInGraphAdjList(n, m, fileName);
+}
+
 vector<int> Tools::ReadMetisOrdering(string const &fileName)
 {
     ifstream instream(fileName.c_str());
@@ -693,3 +723,42 @@ vector<int> Tools::ReadMetisOrdering(string const &fileName)
 
     return ordering;
 }
+
+/*! \brief the name of a file, without its directory and extension.
+*/
+
+string Tools::GetBaseName(string const &fileName)
+{
+    string sBaseName(fileName);
+
+    size_t const lastSlash(sBaseName.find_last_of("/\\"));
+    if (lastSlash != string::npos) {
+        sBaseName = sBaseName.substr(lastSlash+1);
+    }
+
+    size_t const lastDot(sBaseName.find_last_of("."));
+    if (lastDot != string::npos) {
+        sBaseName = sBaseName.substr(0, lastDot);
+    }
+
+    return sBaseName;
+}
+
+/*! \brief parse command line arguments of the form --key=value or --key
+           into a map from key to value (empty if there is no value).
+*/
+
+void Tools::ProcessCommandLineArgs(int const argc, char** argv, map<string, string> &mapCommandLineArgs)
+{
+    for (int i = 1; i < argc; ++i) {
+        string const argument(argv[i]);
+        size_t const positionOfEquals(argument.find_first_of("="));
+        if (positionOfEquals != string::npos) {
+            string const key  (argument.substr(0,positionOfEquals));
+            string const value(argument.substr(positionOfEquals+1));
+            mapCommandLineArgs[key] = value;
+        } else {
+            mapCommandLineArgs[argument] = "";
+        }
+    }
+}
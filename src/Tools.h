@@ -19,6 +19,7 @@
 #include <list>
 #include <vector>
 #include <string>
+#include <map>
 #include <stdio.h>
 
 class Algorithm;
@@ -101,6 +102,10 @@ namespace Tools
     void printList(std::list<int> const &linkedList, void (*printFunc)(int));
     void printInt(int integer);
     std::vector<int> ReadMetisOrdering(std::string const &filename);
+    bool IsMetisFile(std::string const &fileName);
+    std::string GetBaseName(std::string const &fileName);
+    void ProcessCommandLineArgs(int const argc, char** argv, std::map<std::string, std::string> &mapCommandLineArgs);
+    std::vector<std::list<int>> ReadGraph(std::string const &fileName, int &n, int &m);
     std::string GetTimeInSeconds(clock_t delta, bool brackets=true);
 };
 
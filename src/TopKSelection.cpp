@@ -0,0 +1,1164 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "TopKSelection.h"
+#include "CliqueBitsets.h"
+
+// system includes
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/*! \file TopKSelection.cpp
+
+    \brief Choose K maximal cliques that together cover the most vertices:
+           exactly, by trying every choice or by branch and bound, or
+           approximately, by the greedy algorithm, whose choices for all
+           smaller K are the prefixes of its choice for K.
+*/
+
+Solution::~Solution()
+{
+}
+
+/*! \brief the number of choices visited by SelectExhaustive, i.e., the
+           number of multisets of K cliques.
+*/
+
+double TopKSelection::CountChoices(size_t const numCliques, int const K)
+{
+    // (numCliques + K - 1) choose K
+    double choices(1.0);
+    for (int i = 1; i <= K; ++i) {
+        choices = choices * (numCliques + K - i) / i;
+    }
+    return choices;
+}
+
+namespace
+{
+    /*! \brief a choice of cliques as the bitset of the vertices they
+               cover, which is updated in place and restored on Pop.
+    */
+
+    class BitsetChoice
+    {
+    public:
+        //! the search looks for dominated candidates among the bitsets
+        static bool const FINDS_DOMINATED = true;
+
+        BitsetChoice(CliqueBitsets const &bitsets, int const K)
+         : m_Bitsets(bitsets)
+         , m_vCovered(bitsets.GetNumWords(), 0)
+         , m_vUndo(K*bitsets.GetMaxNumWords(), 0)
+         , m_vValues(K + 1, 0)
+         , m_vPath(K, 0)
+         , m_iLevel(0)
+        {
+        }
+
+        BitsetChoice(BitsetChoice &&other);
+        BitsetChoice(BitsetChoice const &other) = delete;
+        ~BitsetChoice();
+
+        //! a choice with no cliques, over the same bitsets as other
+        static BitsetChoice EmptyLike(BitsetChoice const &other);
+
+        int GetValue(int const level) const { return m_vValues[level]; }
+
+        //! the vertices covered by the choice
+        uint64_t const *GetCovered() const { return m_vCovered.data(); }
+
+        //! the value of the choice of level cliques plus the clique at index
+        int GetValueWith(int const level, size_t const index) const
+        {
+            return m_vValues[level] + m_Bitsets.Gain(index, m_vCovered.data());
+        }
+
+        //! best becomes the choice of level cliques plus the clique at index,
+        //! if that is better
+        void Improve(CliqueStore const &cliques, int const level, size_t const index, Solution &best)
+        {
+            if (GetValueWith(level, index) <= best.value) return;
+            Push(level, index);
+            Store(cliques, best);
+            Pop();
+        }
+
+        //! the clique at index becomes clique number level of the choice
+        void Push(int const level, size_t const index)
+        {
+            m_vValues[level + 1] = m_vValues[level] + m_Bitsets.Add(index, m_vCovered.data(), GetUndo(level));
+            m_vPath[level] = index;
+            m_iLevel = level + 1;
+        }
+
+        void Pop()
+        {
+            m_iLevel--;
+            m_Bitsets.Remove(m_vPath[m_iLevel], m_vCovered.data(), GetUndo(m_iLevel));
+        }
+
+        //! best becomes the current choice, which is rare enough to pay for counters
+        void Store(CliqueStore const &cliques, Solution &best) const
+        {
+            best.reset();
+            for (int level = 0; level < m_iLevel; ++level) {
+                best.proc(cliques, m_Bitsets.GetCliqueIndex(m_vPath[level]), 'A');
+            }
+        }
+
+    private:
+        CliqueBitsets const &m_Bitsets;
+        std::vector<uint64_t> m_vCovered; //!< the vertices covered by the choice
+        std::vector<uint64_t> m_vUndo;    //!< the words of m_vCovered before the Push of each level
+        std::vector<int> m_vValues;       //!< the vertices covered by the first level cliques
+        std::vector<size_t> m_vPath;      //!< the clique of each level
+        int m_iLevel;                     //!< the number of cliques in the choice
+
+        uint64_t *GetUndo(int const level) { return m_vUndo.data() + level*m_Bitsets.GetMaxNumWords(); }
+    };
+
+    BitsetChoice::BitsetChoice(BitsetChoice &&other)
+     : m_Bitsets(other.m_Bitsets)
+     , m_vCovered(std::move(other.m_vCovered))
+     , m_vUndo(std::move(other.m_vUndo))
+     , m_vValues(std::move(other.m_vValues))
+     , m_vPath(std::move(other.m_vPath))
+     , m_iLevel(other.m_iLevel)
+    {
+    }
+
+    BitsetChoice BitsetChoice::EmptyLike(BitsetChoice const &other)
+    {
+        return BitsetChoice(other.m_Bitsets, static_cast<int>(other.m_vPath.size()));
+    }
+
+    BitsetChoice::~BitsetChoice()
+    {
+    }
+
+    /*! \brief a choice of cliques as a counter per vertex, for when the
+               bitsets of all cliques would take too much memory: a Push, or
+               the gain of a clique, walks the clique in the store instead
+               of its bitset, and no dominated candidates are looked for.
+    */
+
+    class CounterChoice
+    {
+    public:
+        static bool const FINDS_DOMINATED = false;
+
+        //! the clique at index i of the choice is that at index order[i] of
+        //! the store (e.g., the order of CliqueSizes), or at index i if order
+        //! is empty; the choice keeps a pointer to order, which must outlive
+        //! it, and to every choice made EmptyLike it.
+        CounterChoice(CliqueStore const &cliques, vector<size_t> const &order, int const numVertices, int const K)
+         : m_Cliques(cliques)
+         , m_pOrder(&order)
+         , m_iNumVertices(numVertices)
+         , m_Counters()
+         , m_vValues(K + 1, 0)
+        {
+            assert(order.empty() || order.size() == cliques.size());
+            m_Counters.init(numVertices, K);
+        }
+
+        CounterChoice(CounterChoice &&other);
+        CounterChoice(CounterChoice const &other) = delete;
+        ~CounterChoice();
+
+        //! a choice with no cliques, over the same cliques, order and
+        //! vertices as other
+        static CounterChoice EmptyLike(CounterChoice const &other);
+
+        int GetValue(int const level) const { return m_vValues[level]; }
+
+        //! there is no bitset of the covered vertices
+        uint64_t const *GetCovered() const { return nullptr; }
+
+        int GetValueWith(int const level, size_t const index) const
+        {
+            return m_vValues[level] + m_Counters.gain(m_Cliques, GetCliqueIndex(index));
+        }
+
+        void Improve(CliqueStore const &cliques, int const level, size_t const index, Solution &best)
+        {
+            if (GetValueWith(level, index) <= best.value) return;
+            Push(level, index);
+            Store(cliques, best);
+            Pop();
+        }
+
+        void Push(int const level, size_t const index)
+        {
+            m_Counters.proc(m_Cliques, GetCliqueIndex(index), 'A');
+            m_vValues[level + 1] = m_Counters.value;
+        }
+
+        void Pop()
+        {
+            m_Counters.proc(m_Cliques, m_Counters.chosen().back(), 'D');
+        }
+
+        void Store(CliqueStore const &cliques, Solution &best) const
+        {
+            best.assign(cliques, m_Counters);
+        }
+
+    private:
+        CliqueStore const &m_Cliques;
+        vector<size_t> const *m_pOrder;
+        int m_iNumVertices;
+        Solution m_Counters;        //!< the chosen cliques, by their index in the store
+        vector<int> m_vValues;      //!< the vertices covered by the first level cliques
+
+        size_t GetCliqueIndex(size_t const index) const { return m_pOrder->empty() ? index : (*m_pOrder)[index]; }
+    };
+
+    CounterChoice::CounterChoice(CounterChoice &&other)
+     : m_Cliques(other.m_Cliques)
+     , m_pOrder(other.m_pOrder)
+     , m_iNumVertices(other.m_iNumVertices)
+     , m_Counters(other.m_Counters)
+     , m_vValues(std::move(other.m_vValues))
+    {
+    }
+
+    CounterChoice CounterChoice::EmptyLike(CounterChoice const &other)
+    {
+        return CounterChoice(other.m_Cliques, *other.m_pOrder, other.m_iNumVertices, static_cast<int>(other.m_vValues.size()) - 1);
+    }
+
+    CounterChoice::~CounterChoice()
+    {
+    }
+
+    //! true if the bitsets of the cliques take at most maxBytes, if nonzero
+    bool BitsetsFit(CliqueStore const &cliques, int const numVertices, size_t const maxBytes)
+    {
+        if (maxBytes == 0) return true;
+        size_t numEntries(0);
+        for (size_t i = 0; i < cliques.size(); ++i) numEntries += cliques.GetCliqueSize(i);
+        return CliqueBitsets::GetMaxBytes(cliques.size(), numEntries, numVertices) <= maxBytes;
+    }
+
+    template <typename Choice>
+    void SelectExhaustiveRecursive(CliqueStore const &cliques, int const numVertices, int const K, int const level, size_t const first, Choice &choice, Solution &global_best)
+    {
+        for (size_t i = first; i < cliques.size(); ++i) {
+            // the last clique of a choice is evaluated without changing it
+            if (level + 1 == K) {
+                choice.Improve(cliques, level, i, global_best);
+                continue;
+            }
+            choice.Push(level, i);
+            SelectExhaustiveRecursive(cliques, numVertices, K, level + 1, i, choice, global_best);
+            choice.Pop();
+        }
+    }
+
+    //! SelectExhaustive from the first clique firstIndex, with a choice
+    //! of any representation
+    template <typename Choice>
+    void SelectExhaustiveFrom(CliqueStore const &cliques, int const numVertices, int const K, Solution &best,
+                              size_t const firstIndex, TopKSelection::ProgressCallBack const &progress, Choice &choice)
+    {
+        for (size_t i = firstIndex; i < cliques.size(); ++i) {
+            choice.Push(0, i);
+            if (K == 1) {
+                if (choice.GetValue(1) > best.value) {
+                    choice.Store(cliques, best);
+                }
+            } else {
+                SelectExhaustiveRecursive(cliques, numVertices, K, 1, i, choice, best);
+            }
+            choice.Pop();
+            if (progress) progress(i + 1, best.chosen());
+        }
+    }
+};
+
+/*! \brief choose K cliques (with repetition) maximizing the number of
+           covered vertices, by trying every choice.
+
+    Every choice is visited once, as a non-decreasing sequence of clique
+    indices, which reaches the same best value as visiting every ordered
+    K-tuple.
+
+    \param cliques the candidate cliques.
+
+    \param numVertices the number of vertices in the graph.
+
+    \param K the number of cliques to choose.
+
+    \param best when this function returns, the best choice found.
+*/
+
+void TopKSelection::SelectExhaustive(CliqueStore const &cliques, int const numVertices, int const K, Solution &best)
+{
+    best.init(numVertices, K);
+    SelectExhaustive(cliques, numVertices, K, best, 0, ProgressCallBack());
+}
+
+/*! \brief continue SelectExhaustive from a given first clique, e.g., to
+           resume it from a checkpoint.
+
+    \param best on entry, the best choice among those whose first clique
+                comes before firstIndex (initialized with Solution::init);
+                when this function returns, the best choice found.
+
+    \param firstIndex the index of the first clique of the choices still
+                      to visit.
+
+    \param progress if set, called each time all choices with a given first
+                    clique were visited.
+
+    \param maxBitsetBytes if nonzero, and the bitsets of the cliques may
+                          take more memory than this, the choices are
+                          evaluated with a counter per vertex instead,
+                          which is slower.
+*/
+
+void TopKSelection::SelectExhaustive(CliqueStore const &cliques, int const numVertices, int const K, Solution &best,
+                                     size_t const firstIndex, ProgressCallBack const &progress, size_t const maxBitsetBytes)
+{
+    if (K <= 0) return;
+
+    if (!BitsetsFit(cliques, numVertices, maxBitsetBytes)) {
+        vector<size_t> const storeOrder;
+        CounterChoice choice(cliques, storeOrder, numVertices, K);
+        SelectExhaustiveFrom(cliques, numVertices, K, best, firstIndex, progress, choice);
+        return;
+    }
+
+    CliqueBitsets bitsets;
+    bitsets.Build(cliques, numVertices);
+    BitsetChoice choice(bitsets, K);
+    SelectExhaustiveFrom(cliques, numVertices, K, best, firstIndex, progress, choice);
+}
+
+/*! \brief choose up to K cliques greedily: each clique covers the most
+           vertices not covered by the earlier ones.
+
+    The gain of a clique only decreases as cliques are chosen, so a gain
+    computed earlier is an upper bound, and a clique is only re-evaluated
+    when its old gain is the largest in the queue (lazy evaluation).
+
+    \return the chosen cliques, in the order they were chosen; the first k
+            of them are the greedy choice of k cliques. Fewer than K cliques
+            are returned if the cliques cover all vertices sooner.
+*/
+
+vector<size_t> TopKSelection::SelectGreedy(CliqueStore const &cliques, int const numVertices, int const K)
+{
+    vector<size_t> chosen;
+    if (K <= 0) return chosen;
+
+    Solution solution;
+    solution.init(numVertices, K);
+
+    // (upper bound on the gain, clique); ties prefer the earlier clique
+    auto const isWorse = [](pair<int, size_t> const &left, pair<int, size_t> const &right) {
+        return left.first < right.first || (left.first == right.first && left.second > right.second);
+    };
+    priority_queue<pair<int, size_t>, vector<pair<int, size_t>>, decltype(isWorse)> queue(isWorse);
+    for (size_t i = 0; i < cliques.size(); ++i) {
+        queue.push(make_pair(static_cast<int>(cliques.GetCliqueSize(i)), i));
+    }
+
+    while (static_cast<int>(chosen.size()) < K && !queue.empty()) {
+        pair<int, size_t> top(queue.top());
+        queue.pop();
+        int const gain(solution.gain(cliques, top.second));
+        if (gain == 0) continue;
+        if (!queue.empty() && gain < queue.top().first) {
+            queue.push(make_pair(gain, top.second));
+            continue;
+        }
+        solution.proc(cliques, top.second, 'A');
+        chosen.push_back(top.second);
+    }
+
+    return chosen;
+}
+
+/*! \brief add to a choice the clique that covers the most new vertices.
+
+    \return true if some clique covers a new vertex.
+*/
+
+bool TopKSelection::AddBestClique(CliqueStore const &cliques, Solution &solution)
+{
+    int bestGain(0);
+    size_t bestIndex(0);
+    for (size_t i = 0; i < cliques.size(); ++i) {
+        int const gain(solution.gain(cliques, i));
+        if (gain > bestGain) {
+            bestGain = gain;
+            bestIndex = i;
+        }
+    }
+    if (bestGain == 0) return false;
+    solution.proc(cliques, bestIndex, 'A');
+    return true;
+}
+
+/*! \brief replace chosen cliques, one at a time, by the clique that then
+           covers the most new vertices, until no such swap covers more
+           vertices.
+
+    A greedy choice improved this way is a good first best choice for
+    SelectBranchAndBound: the better it is, the more choices are pruned.
+
+    \return true if the choice was improved.
+*/
+
+bool TopKSelection::ImproveBySwaps(CliqueStore const &cliques, Solution &solution)
+{
+    bool improved(false);
+    bool swapped(true);
+    while (swapped) {
+        swapped = false;
+        for (size_t position = 0; position < solution.chosen().size(); ++position) {
+            int const value(solution.value);
+            size_t const removed(solution.chosen()[position]);
+            solution.remove(cliques, position);
+
+            size_t bestIndex(removed);
+            int bestGain(solution.gain(cliques, removed));
+            for (size_t i = 0; i < cliques.size(); ++i) {
+                int const gain(solution.gain(cliques, i));
+                if (gain > bestGain) {
+                    bestGain = gain;
+                    bestIndex = i;
+                }
+            }
+            solution.proc(cliques, bestIndex, 'A');
+            if (solution.value > value) swapped = improved = true;
+        }
+    }
+    return improved;
+}
+
+namespace
+{
+    /*! \brief the best choice of a branch and bound search, shared by the
+               threads searching: its value is read without a lock, to
+               prune, and the choice is replaced under the lock.
+    */
+
+    class Incumbent
+    {
+    public:
+        explicit Incumbent(Solution &best)
+         : m_Best(best)
+         , m_Mutex()
+         , m_iValue(best.value)
+        {
+        }
+
+        int GetValue() const { return m_iValue.load(memory_order_relaxed); }
+
+        //! the best choice becomes choice, which covers value vertices, if that is better
+        template <typename Choice>
+        void Offer(CliqueStore const &cliques, Choice const &choice, int const value)
+        {
+            lock_guard<mutex> lock(m_Mutex);
+            if (value <= m_Best.value) return;
+            choice.Store(cliques, m_Best);
+            m_iValue.store(value, memory_order_relaxed);
+        }
+
+        //! the lock to hold while reading the best choice
+        mutex &GetMutex() { return m_Mutex; }
+        Solution const &GetBest() const { return m_Best; }
+
+    private:
+        Solution &m_Best;
+        mutex m_Mutex;
+        atomic<int> m_iValue;
+    };
+
+    /*! \brief the order in which the search tries the cliques, the size of
+               each clique, and the largest clique at or after each
+               position, which bound the gain of the cliques still to be
+               chosen.
+
+        Cliques are tried from the largest to the smallest (in the order of
+        the clique store among cliques of the same size), so good choices
+        are found early, and the largest clique after a position is the
+        clique at that position: the search stops at the first clique too
+        small to improve the best choice.
+    */
+
+    class CliqueSizes
+    {
+    public:
+        explicit CliqueSizes(CliqueStore const &cliques)
+         : m_vOrder(cliques.size(), 0)
+         , m_vSizes(cliques.size(), 0)
+         , m_vLargestFrom(cliques.size() + 1, 0)
+        {
+            vector<int> sizes(cliques.size(), 0);
+            for (size_t i = 0; i < cliques.size(); ++i) {
+                m_vOrder[i] = i;
+                sizes[i] = static_cast<int>(cliques.GetCliqueSize(i));
+            }
+            stable_sort(m_vOrder.begin(), m_vOrder.end(), [&sizes](size_t const left, size_t const right) {
+                return sizes[left] > sizes[right];
+            });
+            for (size_t i = cliques.size(); i > 0; --i) {
+                m_vSizes[i - 1] = sizes[m_vOrder[i - 1]];
+                m_vLargestFrom[i - 1] = max(m_vLargestFrom[i], m_vSizes[i - 1]);
+            }
+        }
+
+        //! the clique store index of the clique at each position
+        vector<size_t> const &GetOrder() const { return m_vOrder; }
+
+        int GetSize(size_t const position) const        { return m_vSizes[position];       }
+        int GetLargestFrom(size_t const position) const { return m_vLargestFrom[position]; }
+
+    private:
+        vector<size_t> m_vOrder;
+        vector<int> m_vSizes;
+        vector<int> m_vLargestFrom;
+    };
+
+    /*! \brief finds the candidates of a search node that no best choice
+               needs.
+
+        Candidate A is dominated by candidate B if the vertices of A not
+        covered yet are a subset of those of B: replacing A by B in any
+        choice covers at least as much, so the search may skip A, as long
+        as B, or a candidate dominating B, is searched. Candidates with the
+        same uncovered vertices (found by hashing the sorted words of
+        their uncovered vertices) are dominated by the first of them, and
+        candidates with none are dominated by any. Otherwise B must cover
+        every uncovered vertex of A, so only the candidates containing the
+        uncovered vertex of A in the fewest candidates are tried, and none
+        if there are too many of them.
+    */
+
+    class DominanceFilter
+    {
+    public:
+        explicit DominanceFilter(CliqueBitsets const &bitsets)
+         : m_Bitsets(bitsets)
+         , m_vSignatureOffsets()
+         , m_vSignatureWordIndices()
+         , m_vSignatureWords()
+         , m_vGains()
+         , m_mFirstWithHash()
+         , m_vListCount(bitsets.GetNumActive(), 0)
+         , m_vListEnd(bitsets.GetNumActive(), 0)
+         , m_vListVertices()
+         , m_vLists()
+        {
+        }
+
+        ~DominanceFilter();
+
+        //! dominated[i - first] becomes true for each dominated candidate i
+        //! in [first, end), given the vertices covered by the choice so far
+        void Find(size_t const first, size_t const end, uint64_t const *covered, vector<bool> &dominated)
+        {
+            size_t const numCandidates(end - first);
+            dominated.assign(numCandidates, false);
+            m_vSignatureOffsets.assign(1, 0);
+            m_vSignatureWordIndices.clear();
+            m_vSignatureWords.clear();
+            m_vGains.assign(numCandidates, 0);
+            m_mFirstWithHash.clear();
+
+            for (size_t candidate = 0; candidate < numCandidates; ++candidate) {
+                size_t const index(first + candidate);
+                uint32_t const *wordIndices(m_Bitsets.GetWordIndices(index));
+                uint64_t const *words(m_Bitsets.GetWords(index));
+                uint64_t hash(14695981039346656037ULL);
+                for (size_t i = 0; i < m_Bitsets.GetNumWords(index); ++i) {
+                    uint64_t const uncovered(words[i] & ~covered[wordIndices[i]]);
+                    if (uncovered == 0) continue;
+                    m_vSignatureWordIndices.push_back(wordIndices[i]);
+                    m_vSignatureWords.push_back(uncovered);
+                    m_vGains[candidate] += CliqueBitsets::PopCount(uncovered);
+                    hash = (hash ^ wordIndices[i]) * 1099511628211ULL;
+                    hash = (hash ^ uncovered) * 1099511628211ULL;
+                }
+                m_vSignatureOffsets.push_back(m_vSignatureWords.size());
+
+                if (m_vGains[candidate] == 0) {
+                    dominated[candidate] = true;
+                    continue;
+                }
+                pair<unordered_map<uint64_t, size_t>::iterator, bool> const inserted(m_mFirstWithHash.insert(make_pair(hash, candidate)));
+                if (!inserted.second && IsSubset(candidate, inserted.first->second)) {
+                    dominated[candidate] = true;
+                }
+            }
+
+            FindStrictlyDominated(dominated);
+        }
+
+    private:
+        //! the most candidates tried as dominators of one candidate
+        static size_t const MAX_TRIES = 64;
+
+        CliqueBitsets const &m_Bitsets;
+
+        // the uncovered vertices of each candidate, as the nonzero words of a bitset
+        vector<size_t>   m_vSignatureOffsets;
+        vector<uint32_t> m_vSignatureWordIndices;
+        vector<uint64_t> m_vSignatureWords;
+        vector<int>      m_vGains;
+        unordered_map<uint64_t, size_t> m_mFirstWithHash;
+
+        // the candidates containing each uncovered vertex, in m_vLists
+        // before m_vListEnd[vertex]; only the vertices in m_vListVertices
+        // have nonzero counts, so a reset clears only those
+        vector<size_t> m_vListCount;
+        vector<size_t> m_vListEnd;
+        vector<int>    m_vListVertices;
+        vector<size_t> m_vLists;
+
+        //! true if the uncovered vertices of candidate are a subset of those of other
+        bool IsSubset(size_t const candidate, size_t const other) const
+        {
+            size_t j(m_vSignatureOffsets[other]);
+            size_t const otherEnd(m_vSignatureOffsets[other + 1]);
+            for (size_t i = m_vSignatureOffsets[candidate]; i < m_vSignatureOffsets[candidate + 1]; ++i) {
+                while (j < otherEnd && m_vSignatureWordIndices[j] < m_vSignatureWordIndices[i]) ++j;
+                if (j == otherEnd || m_vSignatureWordIndices[j] != m_vSignatureWordIndices[i]) return false;
+                if ((m_vSignatureWords[i] & ~m_vSignatureWords[j]) != 0) return false;
+            }
+            return true;
+        }
+
+        template <typename Function>
+        void ForEachUncoveredVertex(size_t const candidate, Function const &function) const
+        {
+            for (size_t i = m_vSignatureOffsets[candidate]; i < m_vSignatureOffsets[candidate + 1]; ++i) {
+                uint64_t word(m_vSignatureWords[i]);
+                while (word != 0) {
+                    function(static_cast<int>(m_vSignatureWordIndices[i]*64 + __builtin_ctzll(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        //! candidates whose uncovered vertices are a strict subset of another's
+        void FindStrictlyDominated(vector<bool> &dominated)
+        {
+            size_t const numCandidates(dominated.size());
+
+            // count the candidates containing each vertex, then list them
+            for (size_t candidate = 0; candidate < numCandidates; ++candidate) {
+                if (dominated[candidate]) continue;
+                ForEachUncoveredVertex(candidate, [this](int const vertex) {
+                    if (m_vListCount[vertex]++ == 0) m_vListVertices.push_back(vertex);
+                });
+            }
+            size_t total(0);
+            for (int const vertex : m_vListVertices) {
+                m_vListEnd[vertex] = total;
+                total += m_vListCount[vertex];
+            }
+            m_vLists.resize(total);
+            for (size_t candidate = 0; candidate < numCandidates; ++candidate) {
+                if (dominated[candidate]) continue;
+                ForEachUncoveredVertex(candidate, [this, candidate](int const vertex) {
+                    m_vLists[m_vListEnd[vertex]++] = candidate;
+                });
+            }
+
+            for (size_t candidate = 0; candidate < numCandidates; ++candidate) {
+                if (dominated[candidate]) continue;
+                int rarest(-1);
+                ForEachUncoveredVertex(candidate, [this, &rarest](int const vertex) {
+                    if (rarest < 0 || m_vListCount[vertex] < m_vListCount[rarest]) rarest = vertex;
+                });
+                if (m_vListCount[rarest] > MAX_TRIES) continue;
+                for (size_t i = m_vListEnd[rarest] - m_vListCount[rarest]; i < m_vListEnd[rarest]; ++i) {
+                    size_t const other(m_vLists[i]);
+                    if (m_vGains[other] > m_vGains[candidate] && IsSubset(candidate, other)) {
+                        dominated[candidate] = true;
+                        break;
+                    }
+                }
+            }
+
+            for (int const vertex : m_vListVertices) {
+                m_vListCount[vertex] = 0;
+                m_vListEnd[vertex] = 0;
+            }
+            m_vListVertices.clear();
+        }
+    };
+
+    DominanceFilter::~DominanceFilter()
+    {
+    }
+
+    /*! \brief the state of one thread of a branch and bound search over
+               choices of distinct cliques, in increasing order of index.
+    */
+
+    template <typename Choice>
+    class BranchAndBound
+    {
+    public:
+        BranchAndBound(CliqueStore const &cliques, CliqueBitsets const &bitsets, int const K, CliqueSizes const &sizes,
+                       Incumbent &incumbent, atomic<unsigned long> &nodes, unsigned long const maxNodes)
+         : m_Cliques(cliques)
+         , m_iK(K)
+         , m_Sizes(sizes)
+         , m_Incumbent(incumbent)
+         , m_Nodes(nodes)
+         , m_ulPendingNodes(0)
+         , m_ulMaxNodes(maxNodes)
+         , m_Filter(bitsets)
+         , m_vDominated(K)
+         , m_vDominatedFirst(K, 0)
+        {
+        }
+
+        ~BranchAndBound() { FlushNodes(); }
+
+        //! false if no choice extending one of level cliques covering value
+        //! vertices with cliques from first on can beat the best choice
+        bool MayImprove(int const level, size_t const first, int const value) const
+        {
+            return value + static_cast<long>(m_iK - level) * m_Sizes.GetLargestFrom(first) > m_Incumbent.GetValue();
+        }
+
+        //! true if the clique at index need not be clique number level of a
+        //! choice covering value vertices with level cliques: it is too small
+        //! to beat the best choice, even if the cliques after it are as
+        //! large as the largest one, or another candidate dominates it
+        bool MaySkip(int const level, size_t const index, int const value) const
+        {
+            if (value + m_Sizes.GetSize(index) + static_cast<long>(m_iK - level - 1) * m_Sizes.GetLargestFrom(index + 1) <= m_Incumbent.GetValue()) {
+                return true;
+            }
+            size_t const candidate(index - m_vDominatedFirst[level]);
+            return candidate < m_vDominated[level].size() && m_vDominated[level][candidate];
+        }
+
+        //! forget the dominated candidates for clique number level
+        void ClearDominated(int const level)
+        {
+            m_vDominated[level].clear();
+        }
+
+        /*! \brief true if a search node that chose level cliques, and visited
+                   visited candidates so far, should visit the clique at index.
+
+            Finding dominated candidates costs time linear in their number,
+            so a node only looks for them once it visited enough candidates
+            to show that its subtree is large, and only among the remaining
+            ones. No maximal clique contains another, so nothing is
+            dominated before a clique is chosen, and skipping a last clique
+            saves less than the test costs.
+        */
+        bool ShouldVisit(int const level, size_t const index, size_t &visited, Choice const &choice)
+        {
+            int const value(choice.GetValue(level));
+            if (MaySkip(level, index, value)) return false;
+            if (Choice::FINDS_DOMINATED && level > 0 && level + 1 < m_iK && visited++ == MIN_VISITS_FOR_DOMINANCE) {
+                FindDominated(level, index, choice);
+                return !MaySkip(level, index, value);
+            }
+            return true;
+        }
+
+        //! find the dominated candidates for clique number level, from first on
+        void FindDominated(int const level, size_t const first, Choice const &choice)
+        {
+            m_vDominated[level].clear();
+            m_vDominatedFirst[level] = first;
+
+            // the candidates after the bound stops the search are not needed
+            size_t begin(first), end(m_Cliques.size());
+            while (begin < end) {
+                size_t const middle(begin + (end - begin)/2);
+                if (MayImprove(level, middle, choice.GetValue(level))) begin = middle + 1;
+                else end = middle;
+            }
+            if (end - first < MIN_DOMINANCE_CANDIDATES) return;
+
+            m_Filter.Find(first, end, choice.GetCovered(), m_vDominated[level]);
+        }
+
+        bool OutOfNodes() const
+        {
+            return m_ulMaxNodes != 0 && m_Nodes.load(memory_order_relaxed) + m_ulPendingNodes >= m_ulMaxNodes;
+        }
+
+        //! the nodes of this thread are counted in the shared count in batches
+        void FlushNodes()
+        {
+            m_Nodes.fetch_add(m_ulPendingNodes, memory_order_relaxed);
+            m_ulPendingNodes = 0;
+        }
+
+        //! extend the choice, which has level cliques, with cliques from first on
+        void Search(int const level, size_t const first, Choice &choice)
+        {
+            ClearDominated(level);
+            size_t visited(0);
+            for (size_t i = first; i < m_Cliques.size(); ++i) {
+                if (!MayImprove(level, i, choice.GetValue(level)) || OutOfNodes()) return;
+                if (ShouldVisit(level, i, visited, choice)) Visit(level, i, choice);
+            }
+        }
+
+        void Visit(int const level, size_t const index, Choice &choice)
+        {
+            // the last clique of a choice is evaluated without changing it
+            if (level + 1 == m_iK) {
+                CountNode();
+                int const value(choice.GetValueWith(level, index));
+                if (value <= m_Incumbent.GetValue()) return;
+                choice.Push(level, index);
+                m_Incumbent.Offer(m_Cliques, choice, value);
+                choice.Pop();
+                return;
+            }
+
+            Enter(level, index, choice);
+            Search(level + 1, index + 1, choice);
+            choice.Pop();
+        }
+
+        //! the clique at index becomes clique number level of the choice,
+        //! which has more cliques to come
+        void Enter(int const level, size_t const index, Choice &choice)
+        {
+            CountNode();
+            choice.Push(level, index);
+            if (choice.GetValue(level + 1) > m_Incumbent.GetValue()) {
+                m_Incumbent.Offer(m_Cliques, choice, choice.GetValue(level + 1));
+            }
+        }
+
+    private:
+        static unsigned long const NODES_PER_FLUSH = 1024;
+
+        //! the fewest candidates worth looking for dominated ones
+        static size_t const MIN_DOMINANCE_CANDIDATES = 32;
+
+        //! the candidates a node visits before it looks for dominated ones
+        static size_t const MIN_VISITS_FOR_DOMINANCE = 32;
+
+        CliqueStore const &m_Cliques;
+        int m_iK;
+        CliqueSizes const &m_Sizes;
+        Incumbent &m_Incumbent;
+        atomic<unsigned long> &m_Nodes;
+        unsigned long m_ulPendingNodes;
+        unsigned long m_ulMaxNodes;
+
+        DominanceFilter m_Filter;
+        vector<vector<bool>> m_vDominated; //!< per level, the dominated candidates from m_vDominatedFirst[level] on
+        vector<size_t> m_vDominatedFirst;
+
+        void CountNode()
+        {
+            if (++m_ulPendingNodes == NODES_PER_FLUSH) FlushNodes();
+        }
+    };
+
+    /*! \brief a branch and bound search by several threads, split into one
+               subtree per first clique.
+
+        A thread claims the next first clique nobody claimed yet, and then
+        the second cliques of its subtree one at a time. A thread that finds
+        no first clique left joins the subtree of another thread and claims
+        its remaining second cliques too (work stealing), so the last,
+        largest subtrees do not keep one thread busy while the others idle.
+        A subtree is complete when each of its second cliques was searched
+        or pruned, and the progress callback is called as the complete
+        subtrees grow into a longer prefix of first cliques.
+    */
+
+    template <typename Choice>
+    class ParallelBranchAndBound
+    {
+    public:
+        //! each thread searches with a choice EmptyLike choice
+        ParallelBranchAndBound(CliqueStore const &cliques, CliqueBitsets const &bitsets, Choice const &choice, int const K,
+                               CliqueSizes const &sizes, Incumbent &incumbent, unsigned long const maxNodes,
+                               size_t const firstIndex, TopKSelection::ProgressCallBack const &progress, int const numThreads)
+         : m_Cliques(cliques)
+         , m_Bitsets(bitsets)
+         , m_EmptyChoice(choice)
+         , m_iK(K)
+         , m_Sizes(sizes)
+         , m_Incumbent(incumbent)
+         , m_Nodes(0)
+         , m_ulMaxNodes(maxNodes)
+         , m_FirstIndex(firstIndex)
+         , m_Progress(progress)
+         , m_NextFirst(firstIndex)
+         , m_vNextSecond(cliques.size() - firstIndex)
+         , m_vRemaining(cliques.size() - firstIndex)
+         , m_vCurrent(numThreads)
+         , m_vComplete(cliques.size() - firstIndex, false)
+         , m_CompleteBefore(firstIndex)
+         , m_ProgressMutex()
+         , m_ReportedBefore(firstIndex)
+        {
+            size_t const numCliques(cliques.size());
+            for (size_t first = firstIndex; first < numCliques; ++first) {
+                size_t const numSeconds((K == 1) ? 0 : numCliques - first - 1);
+                m_vNextSecond[first - firstIndex].store(numCliques - numSeconds);
+                m_vRemaining[first - firstIndex].store(numSeconds);
+            }
+            for (atomic<size_t> &current : m_vCurrent) current.store(NONE);
+        }
+
+        ~ParallelBranchAndBound();
+
+        //! \return true if the search completed
+        bool Run()
+        {
+            vector<thread> threads;
+            for (size_t t = 0; t < m_vCurrent.size(); ++t) {
+                threads.push_back(thread(&ParallelBranchAndBound::Work, this, t));
+            }
+            for (thread &worker : threads) worker.join();
+            return m_ulMaxNodes == 0 || m_Nodes.load() < m_ulMaxNodes;
+        }
+
+    private:
+        static size_t const NONE = static_cast<size_t>(-1);
+
+        CliqueStore const &m_Cliques;
+        CliqueBitsets const &m_Bitsets;
+        Choice const &m_EmptyChoice;
+        int m_iK;
+        CliqueSizes const &m_Sizes;
+        Incumbent &m_Incumbent;
+        atomic<unsigned long> m_Nodes;
+        unsigned long m_ulMaxNodes;
+        size_t m_FirstIndex;
+        TopKSelection::ProgressCallBack const &m_Progress;
+
+        atomic<size_t> m_NextFirst;                //!< the next first clique to claim
+        vector<atomic<size_t>> m_vNextSecond;      //!< per first clique, the next second clique to claim
+        vector<atomic<size_t>> m_vRemaining;       //!< per first clique, the second cliques not yet searched or pruned
+        vector<atomic<size_t>> m_vCurrent;         //!< per thread, the first clique of its subtree, or NONE
+
+        // guarded by the mutex of the incumbent
+        vector<bool> m_vComplete;                  //!< per first clique, true if its subtree is complete
+        size_t m_CompleteBefore;                   //!< the subtrees of all first cliques before this one are complete
+
+        mutex m_ProgressMutex;                     //!< held while calling the progress callback
+        size_t m_ReportedBefore;                   //!< the last complete prefix passed to the callback
+
+        void Work(size_t const worker)
+        {
+            Choice choice(Choice::EmptyLike(m_EmptyChoice));
+            BranchAndBound<Choice> search(m_Cliques, m_Bitsets, m_iK, m_Sizes, m_Incumbent, m_Nodes, m_ulMaxNodes);
+            size_t first;
+            while (!search.OutOfNodes() && (ClaimFirst(first) || Steal(worker, first))) {
+                m_vCurrent[worker].store(first);
+                SearchSubtree(first, choice, search);
+                m_vCurrent[worker].store(NONE);
+            }
+        }
+
+        bool ClaimFirst(size_t &first)
+        {
+            first = m_NextFirst.fetch_add(1);
+            return first < m_Cliques.size();
+        }
+
+        //! find a subtree of another thread with second cliques left to claim
+        bool Steal(size_t const worker, size_t &first) const
+        {
+            for (size_t other = 0; other < m_vCurrent.size(); ++other) {
+                if (other == worker) continue;
+                first = m_vCurrent[other].load();
+                if (first != NONE && m_vNextSecond[first - m_FirstIndex].load() < m_Cliques.size()) return true;
+            }
+            return false;
+        }
+
+        void SearchSubtree(size_t const first, Choice &choice, BranchAndBound<Choice> &search)
+        {
+            size_t const numCliques(m_Cliques.size());
+            size_t const task(first - m_FirstIndex);
+
+            // the choices with one clique, or the only clique left, have no
+            // second clique to split on, and are claimed once
+            if (m_iK == 1) {
+                if (search.MayImprove(0, first, 0) && !search.MaySkip(0, first, 0)) search.Visit(0, first, choice);
+                if (!search.OutOfNodes()) Complete(first);
+                return;
+            }
+
+            bool const bEntered(search.MayImprove(0, first, 0) && !search.MaySkip(0, first, 0));
+            if (bEntered) {
+                search.Enter(0, first, choice);
+                search.ClearDominated(1);
+            }
+            if (first + 1 == numCliques) Complete(first);
+
+            size_t second;
+            size_t visited(0);
+            while ((second = m_vNextSecond[task].fetch_add(1)) < numCliques) {
+                size_t searched(1);
+                if (!bEntered || !search.MayImprove(1, second, choice.GetValue(1))) {
+                    // no later second clique can improve either
+                    size_t const next(min(m_vNextSecond[task].exchange(numCliques), numCliques));
+                    searched += numCliques - next;
+                } else if (search.ShouldVisit(1, second, visited, choice)) {
+                    search.Visit(1, second, choice);
+                    if (search.OutOfNodes()) break;
+                }
+                if (m_vRemaining[task].fetch_sub(searched) == searched) Complete(first);
+            }
+
+            if (bEntered) choice.Pop();
+        }
+
+        void Complete(size_t const first)
+        {
+            size_t completeBefore;
+            vector<size_t> best;
+            {
+                lock_guard<mutex> lock(m_Incumbent.GetMutex());
+                m_vComplete[first - m_FirstIndex] = true;
+                size_t const before(m_CompleteBefore);
+                while (m_CompleteBefore < m_Cliques.size() && m_vComplete[m_CompleteBefore - m_FirstIndex]) {
+                    m_CompleteBefore++;
+                }
+                if (m_CompleteBefore == before || !m_Progress) return;
+                completeBefore = m_CompleteBefore;
+                best = m_Incumbent.GetBest().chosen();
+            }
+
+            // the callback may be slow (e.g., it saves a checkpoint), so it
+            // gets a copy of the best choice, and Offer is not held up; a
+            // thread that lost the race with a longer prefix reports nothing
+            lock_guard<mutex> lock(m_ProgressMutex);
+            if (completeBefore <= m_ReportedBefore) return;
+            m_ReportedBefore = completeBefore;
+            m_Progress(completeBefore, best);
+        }
+    };
+
+    template <typename Choice>
+    ParallelBranchAndBound<Choice>::~ParallelBranchAndBound()
+    {
+    }
+
+    //! SelectBranchAndBound, with choices EmptyLike emptyChoice
+    template <typename Choice>
+    bool SelectBranchAndBoundWith(CliqueStore const &cliques, CliqueBitsets const &bitsets, Choice const &emptyChoice, int const K,
+                                  CliqueSizes const &sizes, Incumbent &incumbent, size_t const firstIndex,
+                                  TopKSelection::ProgressCallBack const &progress, unsigned long const maxNodes, int const numThreads)
+    {
+        if (numThreads > 1 && firstIndex < cliques.size()) {
+            ParallelBranchAndBound<Choice> search(cliques, bitsets, emptyChoice, K, sizes, incumbent, maxNodes, firstIndex, progress, numThreads);
+            return search.Run();
+        }
+
+        atomic<unsigned long> nodes(0);
+        BranchAndBound<Choice> search(cliques, bitsets, K, sizes, incumbent, nodes, maxNodes);
+        Choice choice(Choice::EmptyLike(emptyChoice));
+        for (size_t i = firstIndex; i < cliques.size(); ++i) {
+            if (!search.MayImprove(0, i, 0)) break;
+            if (search.OutOfNodes()) return false;
+            if (!search.MaySkip(0, i, 0)) search.Visit(0, i, choice);
+            if (progress) progress(i + 1, incumbent.GetBest().chosen());
+        }
+        return !search.OutOfNodes();
+    }
+};
+
+/*! \brief choose K cliques maximizing the number of covered vertices, by
+           branch and bound.
+
+    Choices are sets of distinct cliques in increasing order of position,
+    where cliques are ordered from the largest to the smallest, and
+    smaller sets are choices too (repeating a clique covers nothing new),
+    so the best value is that of SelectExhaustive. A partial choice is
+    abandoned when even cliques as large as the largest remaining one,
+    covering only new vertices, could not beat the best choice so far; a
+    good best choice on entry (e.g., greedy, improved by ImproveBySwaps, or
+    the best choice for K-1 cliques plus one) prunes the search from the
+    start.
+
+    \param best on entry, the best known choice (initialized with
+                Solution::init); when this function returns, the best
+                choice found.
+
+    \param firstIndex the position, from the largest clique, of the first
+                      clique of the choices still to visit.
+
+    \param progress if set, called each time all choices with a given first
+                    clique were visited, with the position of the next
+                    first clique. With several threads, it is
+                    called when all choices whose first clique comes before
+                    a given one were visited, and never concurrently.
+
+    \param maxNodes if nonzero, the search stops after trying this many
+                    partial choices (in all threads together).
+
+    \param numThreads the number of threads searching the subtrees of the
+                      first cliques; the best value does not depend on it,
+                      but which of several best choices is found may.
+
+    \param maxBitsetBytes if nonzero, and the bitsets of the cliques may
+                          take more memory than this, the choices are
+                          evaluated with a counter per vertex instead, which
+                          is slower, and finds no dominated candidates.
+
+    \return true if the search completed, so best is optimal.
+*/
+
+bool TopKSelection::SelectBranchAndBound(CliqueStore const &cliques, int const numVertices, int const K, Solution &best,
+                                         size_t const firstIndex, ProgressCallBack const &progress,
+                                         unsigned long const maxNodes, int const numThreads, size_t const maxBitsetBytes)
+{
+    if (K <= 0) return true;
+
+    CliqueSizes const sizes(cliques);
+    Incumbent incumbent(best);
+
+    // without bitsets, the bitsets stay empty, and only serve as such to
+    // the search, which finds no dominated candidates
+    CliqueBitsets bitsets;
+    if (!BitsetsFit(cliques, numVertices, maxBitsetBytes)) {
+        CounterChoice const choice(cliques, sizes.GetOrder(), numVertices, K);
+        return SelectBranchAndBoundWith(cliques, bitsets, choice, K, sizes, incumbent, firstIndex, progress, maxNodes, numThreads);
+    }
+
+    bitsets.Build(cliques, numVertices, sizes.GetOrder());
+    BitsetChoice const choice(bitsets, K);
+    return SelectBranchAndBoundWith(cliques, bitsets, choice, K, sizes, incumbent, firstIndex, progress, maxNodes, numThreads);
+}
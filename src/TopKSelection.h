@@ -0,0 +1,172 @@
+#ifndef TOP_K_SELECTION_H
+#define TOP_K_SELECTION_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "CliqueStore.h"
+
+// system includes
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/*! \file TopKSelection.h
+
+    \brief see TopKSelection.cpp
+*/
+
+/*! \class Solution
+
+    \brief A choice of cliques, and the number of vertices they cover.
+
+    A vertex is covered by at most K chosen cliques, so its counter is
+    one byte wide when K < 256, and two bytes wide when K < 65536. The
+    vertices covered since the last reset are listed, so a reset, or a
+    new init with the same number of vertices, only clears those.
+*/
+
+class Solution {
+private:
+    std::vector<uint8_t>  vertex_cover8;  //!< the counters, if K < 256
+    std::vector<uint16_t> vertex_cover16; //!< the counters, if 256 <= K < 65536
+    std::vector<int>      vertex_cover32; //!< the counters, otherwise
+    int width;                            //!< the bytes per counter
+    int num_vertices;
+    std::vector<int> touched;   //!< the vertices covered since the last reset, possibly repeated
+    bool touched_all;           //!< true if touched stopped listing, so a reset clears every counter
+    std::vector<size_t> choose; //!< the indices of the chosen cliques
+
+    int count(int x) const {
+        if (width == 1) return vertex_cover8[x];
+        if (width == 2) return vertex_cover16[x];
+        return vertex_cover32[x];
+    }
+    //! add delta to the counter of x, and return its new value
+    int change(int x, int delta) {
+        if (width == 1) return vertex_cover8[x]  += delta;
+        if (width == 2) return vertex_cover16[x] += delta;
+        return vertex_cover32[x] += delta;
+    }
+public:
+    int value;
+    Solution() : width(4), num_vertices(0), touched_all(false), value(0) {}
+    ~Solution();
+    void init(int n, int K) {
+        int const newWidth(K < 256 ? 1 : (K < 65536 ? 2 : 4));
+        if (n == num_vertices && newWidth == width) {
+            reset();
+        } else {
+            num_vertices = n;
+            width = newWidth;
+            vertex_cover8.assign(width == 1 ? n : 0, 0);
+            vertex_cover16.assign(width == 2 ? n : 0, 0);
+            vertex_cover32.assign(width == 4 ? n : 0, 0);
+            touched.clear();
+            touched_all = false;
+            choose.clear();
+            value = 0;
+        }
+        choose.reserve(K);
+    }
+    //! remove all chosen cliques, in time proportional to the vertices they covered
+    void reset() {
+        if (touched_all) {
+            std::fill(vertex_cover8.begin(), vertex_cover8.end(), 0);
+            std::fill(vertex_cover16.begin(), vertex_cover16.end(), 0);
+            std::fill(vertex_cover32.begin(), vertex_cover32.end(), 0);
+        } else {
+            for (int const x : touched) change(x, -count(x));
+        }
+        touched.clear();
+        touched_all = false;
+        choose.clear();
+        value = 0;
+    }
+    bool operator< (const Solution &rhs) const {
+        return value < rhs.value;
+    }
+    void add(int x) {
+        if (change(x, 1) != 1) return;
+        ++value;
+        // past n entries, clearing every counter is cheaper than the list
+        if (touched_all) return;
+        if (static_cast<int>(touched.size()) < num_vertices) {
+            touched.push_back(x);
+        } else {
+            touched_all = true;
+            std::vector<int>().swap(touched);
+        }
+    }
+    void del(int x) {
+        if (change(x, -1) == 0) --value;
+    }
+    //! the number of vertices of a clique that are not covered yet
+    int gain(const CliqueStore &cliques, size_t index) const {
+        int uncovered(0);
+        cliques.ForEachVertex(index, [this, &uncovered](int x) { if (count(x) == 0) ++uncovered; });
+        return uncovered;
+    }
+    void proc(const CliqueStore &cliques, size_t index, const char &ch) {
+        if (ch == 'A') choose.push_back(index);
+        else choose.pop_back();
+        if (ch == 'A') cliques.ForEachVertex(index, [this](int x) { add(x); });
+        else if (ch == 'D') cliques.ForEachVertex(index, [this](int x) { del(x); });
+        else assert(false);
+    }
+    //! remove the chosen clique at a position; the last chosen clique takes its place
+    void remove(const CliqueStore &cliques, size_t position) {
+        cliques.ForEachVertex(choose[position], [this](int x) { del(x); });
+        choose[position] = choose.back();
+        choose.pop_back();
+    }
+    //! this becomes a choice of the same cliques as other, which was
+    //! initialized with the same number of vertices
+    void assign(const CliqueStore &cliques, const Solution &other) {
+        if (&other == this) return;
+        reset();
+        for (size_t const index : other.choose) proc(cliques, index, 'A');
+    }
+    std::vector<size_t> const &chosen() const {
+        return choose;
+    }
+};
+
+namespace TopKSelection
+{
+    double CountChoices(std::size_t const numCliques, int const K);
+    void SelectExhaustive(CliqueStore const &cliques, int const numVertices, int const K, Solution &best);
+
+    //! called after all choices starting at cliques before nextFirst were
+    //! visited, with the chosen cliques of the best choice so far
+    typedef std::function<void(std::size_t nextFirst, std::vector<std::size_t> const &best)> ProgressCallBack;
+
+    void SelectExhaustive(CliqueStore const &cliques, int const numVertices, int const K, Solution &best,
+                          std::size_t const firstIndex, ProgressCallBack const &progress, std::size_t const maxBitsetBytes = 0);
+
+    std::vector<std::size_t> SelectGreedy(CliqueStore const &cliques, int const numVertices, int const K);
+    bool AddBestClique(CliqueStore const &cliques, Solution &solution);
+    bool ImproveBySwaps(CliqueStore const &cliques, Solution &solution);
+
+    bool SelectBranchAndBound(CliqueStore const &cliques, int const numVertices, int const K, Solution &best,
+                              std::size_t const firstIndex, ProgressCallBack const &progress,
+                              unsigned long const maxNodes = 0, int const numThreads = 1, std::size_t const maxBitsetBytes = 0);
+};
+
+#endif //TOP_K_SELECTION_H
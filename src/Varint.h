@@ -0,0 +1,63 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// system includes
+#include <cstddef>
+#include <cstdint>
+
+/*! \file Varint.h
+
+    \brief Write and read 32-bit values as varints: seven bits per byte,
+           least significant first, with the high bit set on all bytes but
+           the last. The binary format of CliqueWriter and the segments of
+           DiskCliqueStore both store cliques this way.
+*/
+
+namespace Varint
+{
+    //! the most bytes needed to write a 32-bit value
+    size_t const MAX_BYTES = 5;
+
+    /*! \brief write value at buffer[used], and advance used past it; the
+               buffer must have room for MAX_BYTES more bytes.
+    */
+    template <typename Byte>
+    void Put(Byte *buffer, size_t &used, uint32_t value)
+    {
+        while (value >= 0x80) {
+            buffer[used++] = static_cast<Byte>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        buffer[used++] = static_cast<Byte>(value);
+    }
+
+    /*! \brief read the value at p, and advance p past it.
+    */
+    inline uint32_t Get(uint8_t const *&p)
+    {
+        uint32_t value(*p & 0x7F);
+        int shift(7);
+        while (*p++ & 0x80) {
+            value |= static_cast<uint32_t>(*p & 0x7F) << shift;
+            shift += 7;
+        }
+        return value;
+    }
+};
+
+#endif //VARINT_H
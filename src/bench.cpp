@@ -0,0 +1,454 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "Tools.h"
+#include "DegeneracyAlgorithm.h"
+#include "RunReport.h"
+#include "TopKSelection.h"
+
+// system includes
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*! \file bench.cpp
+
+    \brief Benchmark driver: runs each input graph through degeneracy
+           ordering, maximal clique enumeration, and top-k selection for
+           several values of K, repeats each run, and reports the median
+           and 95th percentile wall time of each phase, the enumeration
+           throughput, and the peak resident set size as CSV. Optionally
+           compares the results against a stored baseline.
+
+    Each repetition runs in a child process, so that the peak resident
+    set size of a run is not hidden by the runs before it.
+*/
+
+struct Measurement
+{
+    double parse;
+    double ordering;
+    double enumeration;
+    double selection;
+    double total;
+    long   cliques;
+    long   bestSolution;
+    long   peakRssKB;
+};
+
+struct BenchmarkRow
+{
+    ~BenchmarkRow();
+
+    string graph;
+    int    K;
+    map<string, double> values;
+};
+
+BenchmarkRow::~BenchmarkRow()
+{
+}
+
+static char const *const COLUMNS[] = {
+    "repeats", "cliques", "best_solution",
+    "parse_median_s", "parse_p95_s",
+    "ordering_median_s", "ordering_p95_s",
+    "enumeration_median_s", "enumeration_p95_s",
+    "selection_median_s", "selection_p95_s",
+    "total_median_s", "total_p95_s",
+    "cliques_per_second", "peak_rss_kb"
+};
+
+static int const NUM_COLUMNS = sizeof(COLUMNS)/sizeof(COLUMNS[0]);
+
+//! the time columns compared against the baseline.
+static char const *const COMPARED_TIMES[] = { "ordering_median_s", "enumeration_median_s", "selection_median_s", "total_median_s" };
+
+vector<string> Split(string const &value, char const separator)
+{
+    vector<string> tokens;
+    stringstream strm(value);
+    string token;
+    while (std::getline(strm, token, separator)) {
+        if (!token.empty()) tokens.push_back(token);
+    }
+    return tokens;
+}
+
+vector<string> ListDirectory(string const &directory)
+{
+    vector<string> files;
+    DIR *pDirectory(opendir(directory.c_str()));
+    if (pDirectory == nullptr) {
+        fprintf(stderr, "ERROR: unable to open directory %s\n", directory.c_str());
+        exit(1);
+    }
+
+    struct dirent *pEntry(nullptr);
+    while ((pEntry = readdir(pDirectory)) != nullptr) {
+        string const name(pEntry->d_name);
+        if (name.empty() || name[0] == '.') continue;
+        files.push_back(directory + "/" + name);
+    }
+    closedir(pDirectory);
+
+    sort(files.begin(), files.end());
+    return files;
+}
+
+double SecondsSince(chrono::steady_clock::time_point const &start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/*! \brief run the whole pipeline once, in the calling process.
+*/
+
+Measurement RunOnce(string const &inputFile, int const K)
+{
+    typedef chrono::steady_clock Clock;
+    Measurement measurement;
+
+    Clock::time_point const start(Clock::now());
+
+    int n(0), m(0);
+    vector<list<int>> adjacencyList(Tools::ReadGraph(inputFile, n, m));
+    measurement.parse = SecondsSince(start);
+
+    Clock::time_point const startOrdering(Clock::now());
+    DegeneracyAlgorithm algorithm(std::move(adjacencyList));
+    measurement.ordering = SecondsSince(startOrdering);
+
+    CliqueStore cliques;
+    algorithm.AddCallBack([&cliques](list<int> const &clique) { cliques.Add(clique.begin(), clique.end()); });
+    algorithm.SetQuiet(true);
+
+    Clock::time_point const startEnumeration(Clock::now());
+    list<list<int>> unused;
+    measurement.cliques = algorithm.Run(unused);
+    measurement.enumeration = SecondsSince(startEnumeration);
+
+    Clock::time_point const startSelection(Clock::now());
+    Solution best;
+    TopKSelection::SelectExhaustive(cliques, n, K, best);
+    measurement.selection = SecondsSince(startSelection);
+    measurement.bestSolution = best.value;
+
+    measurement.total = SecondsSince(start);
+    measurement.peakRssKB = RunReport::GetPeakResidentSetKB();
+    return measurement;
+}
+
+/*! \brief run the pipeline once in a child process, and collect its measurement.
+*/
+
+bool RunIsolated(string const &inputFile, int const K, Measurement &measurement)
+{
+    int fileDescriptors[2];
+    if (pipe(fileDescriptors) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+
+    pid_t const pid(fork());
+    if (pid < 0) {
+        perror("fork");
+        exit(1);
+    }
+
+    if (pid == 0) {
+        close(fileDescriptors[0]);
+        Measurement const result(RunOnce(inputFile, K));
+        ssize_t const written(write(fileDescriptors[1], &result, sizeof(result)));
+        close(fileDescriptors[1]);
+        _exit(written == sizeof(result) ? 0 : 1);
+    }
+
+    close(fileDescriptors[1]);
+    ssize_t const bytesRead(read(fileDescriptors[0], &measurement, sizeof(measurement)));
+    close(fileDescriptors[0]);
+
+    int status(0);
+    waitpid(pid, &status, 0);
+    return bytesRead == sizeof(measurement) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+double Median(vector<double> values)
+{
+    sort(values.begin(), values.end());
+    size_t const size(values.size());
+    if (size == 0) return 0.0;
+    if (size % 2 == 1) return values[size/2];
+    return (values[size/2 - 1] + values[size/2])/2.0;
+}
+
+//! nearest-rank percentile
+double Percentile(vector<double> values, double const fraction)
+{
+    sort(values.begin(), values.end());
+    if (values.empty()) return 0.0;
+    size_t rank(static_cast<size_t>(ceil(fraction * values.size())));
+    if (rank == 0) rank = 1;
+    return values[rank - 1];
+}
+
+BenchmarkRow Summarize(string const &graph, int const K, vector<Measurement> const &measurements)
+{
+    BenchmarkRow row;
+    row.graph = graph;
+    row.K = K;
+
+    vector<double> parse, ordering, enumeration, selection, total;
+    long peakRssKB(0);
+    for (Measurement const &measurement : measurements) {
+        parse.push_back(measurement.parse);
+        ordering.push_back(measurement.ordering);
+        enumeration.push_back(measurement.enumeration);
+        selection.push_back(measurement.selection);
+        total.push_back(measurement.total);
+        peakRssKB = max(peakRssKB, measurement.peakRssKB);
+    }
+
+    row.values["repeats"]              = measurements.size();
+    row.values["cliques"]              = measurements.front().cliques;
+    row.values["best_solution"]        = measurements.front().bestSolution;
+    row.values["parse_median_s"]       = Median(parse);
+    row.values["parse_p95_s"]          = Percentile(parse, 0.95);
+    row.values["ordering_median_s"]    = Median(ordering);
+    row.values["ordering_p95_s"]       = Percentile(ordering, 0.95);
+    row.values["enumeration_median_s"] = Median(enumeration);
+    row.values["enumeration_p95_s"]    = Percentile(enumeration, 0.95);
+    row.values["selection_median_s"]   = Median(selection);
+    row.values["selection_p95_s"]      = Percentile(selection, 0.95);
+    row.values["total_median_s"]       = Median(total);
+    row.values["total_p95_s"]          = Percentile(total, 0.95);
+    row.values["cliques_per_second"]   = (Median(enumeration) > 0.0) ? (measurements.front().cliques / Median(enumeration)) : 0.0;
+    row.values["peak_rss_kb"]          = peakRssKB;
+    return row;
+}
+
+void PrintHeader(ostream &out)
+{
+    out << "graph,K";
+    for (int column = 0; column < NUM_COLUMNS; ++column) {
+        out << "," << COLUMNS[column];
+    }
+    out << endl;
+}
+
+void PrintRow(ostream &out, BenchmarkRow const &row)
+{
+    out << row.graph << "," << row.K;
+    for (int column = 0; column < NUM_COLUMNS; ++column) {
+        char buffer[64];
+        double const value(row.values.at(COLUMNS[column]));
+        if (value == floor(value) && fabs(value) < 1e15) {
+            snprintf(buffer, sizeof(buffer), "%.0f", value);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%.6f", value);
+        }
+        out << "," << buffer;
+    }
+    out << endl << flush;
+}
+
+vector<BenchmarkRow> ReadRows(string const &fileName)
+{
+    vector<BenchmarkRow> rows;
+    ifstream instream(fileName.c_str());
+    if (!instream.good()) {
+        fprintf(stderr, "ERROR: unable to read baseline file %s\n", fileName.c_str());
+        exit(1);
+    }
+
+    string line;
+    std::getline(instream, line);
+    vector<string> const header(Split(line, ','));
+
+    while (std::getline(instream, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        vector<string> const fields(Split(line, ','));
+        if (fields.size() != header.size() || fields.size() < 2) continue;
+        BenchmarkRow row;
+        row.graph = fields[0];
+        row.K = atoi(fields[1].c_str());
+        for (size_t column = 2; column < fields.size(); ++column) {
+            row.values[header[column]] = atof(fields[column].c_str());
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+/*! \brief compare results with a baseline, and report every time or
+           memory measurement that grew by more than the threshold.
+
+    \return the number of regressions found.
+*/
+
+int CompareWithBaseline(vector<BenchmarkRow> const &rows, vector<BenchmarkRow> const &baseline, double const threshold, double const minimumDelta)
+{
+    int numRegressions(0);
+    for (BenchmarkRow const &row : rows) {
+        BenchmarkRow const *pBase(nullptr);
+        for (BenchmarkRow const &candidate : baseline) {
+            if (candidate.graph == row.graph && candidate.K == row.K) pBase = &candidate;
+        }
+
+        if (pBase == nullptr) {
+            cerr << "NOTE: no baseline for " << row.graph << " K=" << row.K << endl;
+            continue;
+        }
+
+        for (char const *column : COMPARED_TIMES) {
+            if (pBase->values.find(column) == pBase->values.end()) continue;
+            double const before(pBase->values.at(column));
+            double const after(row.values.at(column));
+            if (after > before * (1.0 + threshold) && after - before > minimumDelta) {
+                fprintf(stderr, "REGRESSION: %s K=%d %s %.6f -> %.6f (%+.1f%%)\n", row.graph.c_str(), row.K, column, before, after, before > 0.0 ? 100.0*(after-before)/before : 100.0);
+                numRegressions++;
+            }
+        }
+
+        if (pBase->values.find("peak_rss_kb") != pBase->values.end()) {
+            double const before(pBase->values.at("peak_rss_kb"));
+            double const after(row.values.at("peak_rss_kb"));
+            // ignore small allocator noise
+            if (after > before * (1.0 + threshold) && after - before > 1024.0) {
+                fprintf(stderr, "REGRESSION: %s K=%d peak_rss_kb %.0f -> %.0f (%+.1f%%)\n", row.graph.c_str(), row.K, before, after, before > 0.0 ? 100.0*(after-before)/before : 100.0);
+                numRegressions++;
+            }
+        }
+
+        if (pBase->values.find("cliques") != pBase->values.end() && pBase->values.at("cliques") != row.values.at("cliques")) {
+            fprintf(stderr, "MISMATCH: %s K=%d cliques %.0f -> %.0f\n", row.graph.c_str(), row.K, pBase->values.at("cliques"), row.values.at("cliques"));
+            numRegressions++;
+        }
+        if (pBase->values.find("best_solution") != pBase->values.end() && pBase->values.at("best_solution") != row.values.at("best_solution")) {
+            fprintf(stderr, "MISMATCH: %s K=%d best_solution %.0f -> %.0f\n", row.graph.c_str(), row.K, pBase->values.at("best_solution"), row.values.at("best_solution"));
+            numRegressions++;
+        }
+    }
+    return numRegressions;
+}
+
+void ShowUsage(char const *program)
+{
+    cerr << "USAGE: " << program << " [--input-files=<file,file,...>|--input-dir=<directory>] [--K=<k,k,...>] [--repeat=<n>]" << endl;
+    cerr << "       [--selection-budget=<choices>] [--output=<csv file>] [--baseline=<csv file>] [--threshold=<fraction>] [--min-delta=<seconds>]" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    map<string, string> mapCommandLineArgs;
+    Tools::ProcessCommandLineArgs(argc, argv, mapCommandLineArgs);
+
+    if (mapCommandLineArgs.find("--help") != mapCommandLineArgs.end()) {
+        ShowUsage(argv[0]);
+        return 0;
+    }
+
+    string const inputDirectory((mapCommandLineArgs.find("--input-dir") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--input-dir"] : "data/biogrid");
+    vector<string> inputFiles;
+    if (mapCommandLineArgs.find("--input-files") != mapCommandLineArgs.end()) {
+        inputFiles = Split(mapCommandLineArgs["--input-files"], ',');
+    } else {
+        inputFiles = ListDirectory(inputDirectory);
+    }
+
+    vector<int> valuesOfK;
+    for (string const &value : Split((mapCommandLineArgs.find("--K") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--K"] : "1,2", ',')) {
+        valuesOfK.push_back(atoi(value.c_str()));
+    }
+
+    int const repeats((mapCommandLineArgs.find("--repeat") != mapCommandLineArgs.end()) ? max(1, atoi(mapCommandLineArgs["--repeat"].c_str())) : 5);
+    double const selectionBudget((mapCommandLineArgs.find("--selection-budget") != mapCommandLineArgs.end()) ? atof(mapCommandLineArgs["--selection-budget"].c_str()) : 5e7);
+    double const threshold((mapCommandLineArgs.find("--threshold") != mapCommandLineArgs.end()) ? atof(mapCommandLineArgs["--threshold"].c_str()) : 0.10);
+    double const minimumDelta((mapCommandLineArgs.find("--min-delta") != mapCommandLineArgs.end()) ? atof(mapCommandLineArgs["--min-delta"].c_str()) : 0.005);
+
+    ofstream outputFile;
+    bool const bWriteFile(mapCommandLineArgs.find("--output") != mapCommandLineArgs.end());
+    if (bWriteFile) {
+        outputFile.open(mapCommandLineArgs["--output"].c_str());
+        if (!outputFile.good()) {
+            fprintf(stderr, "ERROR: unable to write %s\n", mapCommandLineArgs["--output"].c_str());
+            return 1;
+        }
+    }
+    ostream &out(bWriteFile ? static_cast<ostream&>(outputFile) : cout);
+
+    PrintHeader(out);
+
+    vector<BenchmarkRow> rows;
+    for (string const &inputFile : inputFiles) {
+        string const graph(Tools::GetBaseName(inputFile));
+
+        // count the cliques once, to keep the exhaustive selection within budget.
+        Measurement counting;
+        if (!RunIsolated(inputFile, 0, counting)) {
+            fprintf(stderr, "ERROR: run on %s failed\n", inputFile.c_str());
+            return 1;
+        }
+
+        for (int const K : valuesOfK) {
+            double const choices(TopKSelection::CountChoices(counting.cliques, K));
+            if (choices > selectionBudget) {
+                fprintf(stderr, "NOTE: skipping %s K=%d: %.3g choices exceeds the selection budget of %.3g\n", graph.c_str(), K, choices, selectionBudget);
+                continue;
+            }
+
+            vector<Measurement> measurements;
+            for (int repeat = 0; repeat < repeats; ++repeat) {
+                Measurement measurement;
+                if (!RunIsolated(inputFile, K, measurement)) {
+                    fprintf(stderr, "ERROR: run on %s with K=%d failed\n", inputFile.c_str(), K);
+                    return 1;
+                }
+                measurements.push_back(measurement);
+            }
+
+            rows.push_back(Summarize(graph, K, measurements));
+            PrintRow(out, rows.back());
+        }
+    }
+
+    if (mapCommandLineArgs.find("--baseline") != mapCommandLineArgs.end()) {
+        vector<BenchmarkRow> const baseline(ReadRows(mapCommandLineArgs["--baseline"]));
+        int const numRegressions(CompareWithBaseline(rows, baseline, threshold, minimumDelta));
+        if (numRegressions != 0) {
+            fprintf(stderr, "%d regression(s) beyond %.0f%% of baseline %s\n", numRegressions, 100.0*threshold, mapCommandLineArgs["--baseline"].c_str());
+            return 2;
+        }
+        fprintf(stderr, "No regressions beyond %.0f%% of baseline %s\n", 100.0*threshold, mapCommandLineArgs["--baseline"].c_str());
+    }
+
+    return 0;
+}
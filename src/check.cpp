@@ -0,0 +1,235 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "Tools.h"
+#include "DegeneracyAlgorithm.h"
+#include "TopKSelection.h"
+
+// system includes
+#include <dirent.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*! \file check.cpp
+
+    \brief Regression check of the top-k selection: for each input graph
+           and value of K, compares the value of the best choice found by
+           SelectBranchAndBound, with one and several threads, with and
+           without clique bitsets, and from an empty or a greedy first best
+           choice, against that of SelectExhaustive, and checks that each
+           choice has at most K cliques and covers as many vertices as
+           reported.
+
+    The exhaustive search visits every choice, so the check runs on an
+    evenly spaced sample of at most --max-cliques of the maximal cliques of
+    each graph, which is an instance of the selection like any other.
+    Prints one CSV row per graph and K, and exits with a non-zero status
+    if any value differs.
+*/
+
+//! the searches compared, after the exhaustive one
+static char const *const SEARCHES[] = {
+    "branch_and_bound", "branch_and_bound_threads", "counters", "counters_threads", "greedy_first", "exhaustive_counters"
+};
+
+static int const NUM_SEARCHES = sizeof(SEARCHES)/sizeof(SEARCHES[0]);
+
+vector<string> Split(string const &value, char const separator)
+{
+    vector<string> tokens;
+    stringstream strm(value);
+    string token;
+    while (std::getline(strm, token, separator)) {
+        if (!token.empty()) tokens.push_back(token);
+    }
+    return tokens;
+}
+
+vector<string> ListDirectory(string const &directory)
+{
+    vector<string> files;
+    DIR *pDirectory(opendir(directory.c_str()));
+    if (pDirectory == nullptr) {
+        fprintf(stderr, "ERROR: unable to open directory %s\n", directory.c_str());
+        exit(1);
+    }
+
+    struct dirent *pEntry(nullptr);
+    while ((pEntry = readdir(pDirectory)) != nullptr) {
+        string const name(pEntry->d_name);
+        if (name.empty() || name[0] == '.') continue;
+        files.push_back(directory + "/" + name);
+    }
+    closedir(pDirectory);
+
+    sort(files.begin(), files.end());
+    return files;
+}
+
+/*! \brief the maximal cliques of a graph, or an evenly spaced sample of
+           at most maxCliques of them.
+*/
+
+void SampleCliques(string const &inputFile, size_t const maxCliques, int &n, CliqueStore &sample)
+{
+    int m(0);
+    vector<list<int>> adjacencyList(Tools::ReadGraph(inputFile, n, m));
+    DegeneracyAlgorithm algorithm(std::move(adjacencyList));
+
+    CliqueStore cliques;
+    algorithm.AddCallBack([&cliques](list<int> const &clique) { cliques.Add(clique.begin(), clique.end()); });
+    algorithm.SetQuiet(true);
+    list<list<int>> unused;
+    algorithm.Run(unused);
+
+    size_t const numSampled(min(cliques.size(), maxCliques));
+    vector<int> clique;
+    for (size_t i = 0; i < numSampled; ++i) {
+        cliques.GetClique(i*cliques.size()/numSampled, clique);
+        sample.Add(clique.begin(), clique.end());
+    }
+}
+
+/*! \brief the value of a choice, or -1 if it has more than K cliques, or
+           does not cover the vertices it reports.
+*/
+
+int CheckedValue(CliqueStore const &cliques, int const n, int const K, Solution const &solution)
+{
+    if (static_cast<int>(solution.chosen().size()) > K) return -1;
+    Solution recount;
+    recount.init(n, K);
+    for (size_t const index : solution.chosen()) {
+        if (index >= cliques.size()) return -1;
+        recount.proc(cliques, index, 'A');
+    }
+    return (recount.value == solution.value) ? solution.value : -1;
+}
+
+/*! \brief run every search on the cliques for one K.
+
+    \return the value found by each search of SEARCHES.
+*/
+
+vector<int> RunSearches(CliqueStore const &cliques, int const n, int const K, int const numThreads)
+{
+    // a limit of one byte is below the footprint of any bitsets
+    size_t const noBitsets(1);
+    TopKSelection::ProgressCallBack const noProgress;
+
+    vector<int> values;
+    for (int search = 0; search < NUM_SEARCHES; ++search) {
+        string const name(SEARCHES[search]);
+        Solution best;
+        best.init(n, K);
+        if (name == "branch_and_bound") {
+            TopKSelection::SelectBranchAndBound(cliques, n, K, best, 0, noProgress);
+        } else if (name == "branch_and_bound_threads") {
+            TopKSelection::SelectBranchAndBound(cliques, n, K, best, 0, noProgress, 0, numThreads);
+        } else if (name == "counters") {
+            TopKSelection::SelectBranchAndBound(cliques, n, K, best, 0, noProgress, 0, 1, noBitsets);
+        } else if (name == "counters_threads") {
+            TopKSelection::SelectBranchAndBound(cliques, n, K, best, 0, noProgress, 0, numThreads, noBitsets);
+        } else if (name == "greedy_first") {
+            for (size_t const index : TopKSelection::SelectGreedy(cliques, n, K)) {
+                best.proc(cliques, index, 'A');
+            }
+            TopKSelection::ImproveBySwaps(cliques, best);
+            TopKSelection::SelectBranchAndBound(cliques, n, K, best, 0, noProgress, 0, numThreads);
+        } else if (name == "exhaustive_counters") {
+            TopKSelection::SelectExhaustive(cliques, n, K, best, 0, noProgress, noBitsets);
+        }
+        values.push_back(CheckedValue(cliques, n, K, best));
+    }
+    return values;
+}
+
+void ShowUsage(char const *program)
+{
+    cerr << "USAGE: " << program << " [--input-files=<file,file,...>|--input-dir=<directory>] [--K=<k,k,...>] [--threads=<n>] [--max-cliques=<n>]" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    map<string, string> mapCommandLineArgs;
+    Tools::ProcessCommandLineArgs(argc, argv, mapCommandLineArgs);
+
+    if (mapCommandLineArgs.find("--help") != mapCommandLineArgs.end()) {
+        ShowUsage(argv[0]);
+        return 0;
+    }
+
+    string const inputDirectory((mapCommandLineArgs.find("--input-dir") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--input-dir"] : "data/biogrid");
+    vector<string> inputFiles;
+    if (mapCommandLineArgs.find("--input-files") != mapCommandLineArgs.end()) {
+        inputFiles = Split(mapCommandLineArgs["--input-files"], ',');
+    } else {
+        inputFiles = ListDirectory(inputDirectory);
+    }
+
+    vector<int> valuesOfK;
+    for (string const &value : Split((mapCommandLineArgs.find("--K") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--K"] : "1,2,3,4", ',')) {
+        valuesOfK.push_back(atoi(value.c_str()));
+    }
+
+    int const numThreads((mapCommandLineArgs.find("--threads") != mapCommandLineArgs.end()) ? max(2, atoi(mapCommandLineArgs["--threads"].c_str())) : 4);
+    size_t const maxCliques((mapCommandLineArgs.find("--max-cliques") != mapCommandLineArgs.end()) ? max(1L, atol(mapCommandLineArgs["--max-cliques"].c_str())) : 80);
+
+    cout << "graph,K,cliques,exhaustive";
+    for (int search = 0; search < NUM_SEARCHES; ++search) cout << "," << SEARCHES[search];
+    cout << endl;
+
+    int numMismatches(0);
+    for (string const &inputFile : inputFiles) {
+        string const graph(Tools::GetBaseName(inputFile));
+        int n(0);
+        CliqueStore cliques;
+        SampleCliques(inputFile, maxCliques, n, cliques);
+
+        for (int const K : valuesOfK) {
+            Solution exhaustive;
+            TopKSelection::SelectExhaustive(cliques, n, K, exhaustive);
+            int const expected(CheckedValue(cliques, n, K, exhaustive));
+            vector<int> const values(RunSearches(cliques, n, K, numThreads));
+
+            cout << graph << "," << K << "," << cliques.size() << "," << expected;
+            for (int search = 0; search < NUM_SEARCHES; ++search) {
+                cout << "," << values[search];
+                if (values[search] != expected || expected < 0) {
+                    fprintf(stderr, "MISMATCH: %s K=%d %s %d, exhaustive %d\n", graph.c_str(), K, SEARCHES[search], values[search], expected);
+                    numMismatches++;
+                }
+            }
+            cout << endl << flush;
+        }
+    }
+
+    if (numMismatches != 0) {
+        fprintf(stderr, "%d mismatch(es) with the exhaustive selection\n", numMismatches);
+        return 1;
+    }
+    fprintf(stderr, "All selections match the exhaustive selection\n");
+    return 0;
+}
@@ -0,0 +1,321 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// local includes
+#include "Tools.h"
+
+// system includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*! \file gengraph.cpp
+
+    \brief generate synthetic graphs for scaling experiments, in the
+           custom one edge per line format (.edges) or the METIS format.
+
+    Supported models:
+
+     - er: Erdos-Renyi G(n,m), m edges chosen uniformly at random.
+     - ba: Barabasi-Albert preferential attachment, each new vertex
+           attaches to --attach existing vertices (degeneracy = --attach).
+     - rmat: R-MAT/Kronecker graph with 2^--scale vertices and --m edge
+           samples, using quadrant probabilities --a, --b, --c.
+     - planted: --cliques cliques of --clique-size vertices planted on
+           random vertex sets (degeneracy >= size-1), and random edges
+           added until there are m edges.
+
+    Loops and duplicate edges are removed, so the number of edges in the
+    output may be slightly smaller than requested for rmat.
+*/
+
+typedef uint64_t EdgeKey;
+
+inline EdgeKey MakeEdgeKey(uint32_t const u, uint32_t const v)
+{
+    return (u < v) ? ((static_cast<EdgeKey>(u) << 32) | v) : ((static_cast<EdgeKey>(v) << 32) | u);
+}
+
+inline uint32_t EdgeKeyFirst(EdgeKey const key)  { return static_cast<uint32_t>(key >> 32); }
+inline uint32_t EdgeKeySecond(EdgeKey const key) { return static_cast<uint32_t>(key & 0xFFFFFFFFu); }
+
+void SortAndRemoveDuplicates(vector<EdgeKey> &edges)
+{
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+}
+
+/*! \brief add uniformly random edges until there are numEdges distinct edges.
+*/
+
+void AddRandomEdges(vector<EdgeKey> &edges, uint32_t const n, uint64_t const numEdges, mt19937_64 &generator)
+{
+    uint64_t const maximumEdges(static_cast<uint64_t>(n) * (n - 1) / 2);
+    if (numEdges > maximumEdges) {
+        fprintf(stderr, "ERROR: cannot place %llu edges on %u vertices\n", static_cast<unsigned long long>(numEdges), n);
+        exit(1);
+    }
+
+    uniform_int_distribution<uint32_t> vertex(0, n - 1);
+    SortAndRemoveDuplicates(edges);
+    while (edges.size() < numEdges) {
+        uint64_t const missing(numEdges - edges.size());
+        for (uint64_t i = 0; i < missing; ++i) {
+            uint32_t const u(vertex(generator));
+            uint32_t const v(vertex(generator));
+            if (u != v) edges.push_back(MakeEdgeKey(u, v));
+        }
+        SortAndRemoveDuplicates(edges);
+    }
+
+}
+
+vector<EdgeKey> GenerateErdosRenyi(uint32_t const n, uint64_t const m, mt19937_64 &generator)
+{
+    vector<EdgeKey> edges;
+    edges.reserve(m);
+    AddRandomEdges(edges, n, m, generator);
+    return edges;
+}
+
+vector<EdgeKey> GenerateBarabasiAlbert(uint32_t const n, uint32_t const attach, mt19937_64 &generator)
+{
+    vector<EdgeKey> edges;
+    if (attach == 0 || n <= attach) {
+        fprintf(stderr, "ERROR: ba model requires 0 < --attach < --n\n");
+        exit(1);
+    }
+
+    // each vertex appears in targets once per incident edge, so that
+    // sampling from targets is sampling proportional to degree.
+    vector<uint32_t> targets;
+    targets.reserve(2 * static_cast<size_t>(n) * attach);
+
+    // start with a clique on attach+1 vertices
+    for (uint32_t u = 0; u <= attach; ++u) {
+        for (uint32_t v = u + 1; v <= attach; ++v) {
+            edges.push_back(MakeEdgeKey(u, v));
+            targets.push_back(u);
+            targets.push_back(v);
+        }
+    }
+
+    vector<uint32_t> chosen;
+    for (uint32_t vertex = attach + 1; vertex < n; ++vertex) {
+        uniform_int_distribution<size_t> index(0, targets.size() - 1);
+        chosen.clear();
+        while (chosen.size() < attach) {
+            uint32_t const target(targets[index(generator)]);
+            if (find(chosen.begin(), chosen.end(), target) == chosen.end()) {
+                chosen.push_back(target);
+            }
+        }
+
+        for (uint32_t const target : chosen) {
+            edges.push_back(MakeEdgeKey(vertex, target));
+            targets.push_back(vertex);
+            targets.push_back(target);
+        }
+    }
+
+    SortAndRemoveDuplicates(edges);
+    return edges;
+}
+
+vector<EdgeKey> GenerateRMat(uint32_t const scale, uint64_t const m, double const a, double const b, double const c, mt19937_64 &generator)
+{
+    if (scale == 0 || scale > 31 || a < 0.0 || b < 0.0 || c < 0.0 || a + b + c > 1.0) {
+        fprintf(stderr, "ERROR: rmat model requires 0 < --scale <= 31 and a + b + c <= 1\n");
+        exit(1);
+    }
+
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    vector<EdgeKey> edges;
+    edges.reserve(m);
+    for (uint64_t i = 0; i < m; ++i) {
+        uint32_t u(0), v(0);
+        for (uint32_t level = 0; level < scale; ++level) {
+            double const r(coin(generator));
+            u <<= 1;
+            v <<= 1;
+            if (r < a) {
+            } else if (r < a + b) {
+                v |= 1;
+            } else if (r < a + b + c) {
+                u |= 1;
+            } else {
+                u |= 1;
+                v |= 1;
+            }
+        }
+        if (u != v) edges.push_back(MakeEdgeKey(u, v));
+    }
+
+    SortAndRemoveDuplicates(edges);
+    return edges;
+}
+
+vector<EdgeKey> GeneratePlantedCliques(uint32_t const n, uint64_t const m, uint32_t const cliqueSize, uint32_t const numCliques, mt19937_64 &generator)
+{
+    if (cliqueSize > n) {
+        fprintf(stderr, "ERROR: --clique-size must not exceed --n\n");
+        exit(1);
+    }
+
+    vector<EdgeKey> edges;
+    vector<uint32_t> vertices(n);
+    for (uint32_t vertex = 0; vertex < n; ++vertex) vertices[vertex] = vertex;
+
+    for (uint32_t clique = 0; clique < numCliques; ++clique) {
+        // partial Fisher-Yates shuffle picks cliqueSize distinct vertices
+        for (uint32_t i = 0; i < cliqueSize; ++i) {
+            uniform_int_distribution<uint32_t> index(i, n - 1);
+            swap(vertices[i], vertices[index(generator)]);
+        }
+        for (uint32_t i = 0; i < cliqueSize; ++i) {
+            for (uint32_t j = i + 1; j < cliqueSize; ++j) {
+                edges.push_back(MakeEdgeKey(vertices[i], vertices[j]));
+            }
+        }
+    }
+
+    SortAndRemoveDuplicates(edges);
+    // the planted edges count towards m
+    AddRandomEdges(edges, n, max<uint64_t>(m, edges.size()), generator);
+    return edges;
+}
+
+/*! \brief write the graph, either as one edge per line (both directions),
+           or in the METIS format, with one-based neighbor lists.
+*/
+
+void WriteGraph(FILE *out, uint32_t const n, vector<EdgeKey> const &edges, bool const metis)
+{
+    // compressed adjacency, so that neighbors are written in sorted order
+    vector<uint64_t> offsets(static_cast<size_t>(n) + 1, 0);
+    for (EdgeKey const edge : edges) {
+        offsets[EdgeKeyFirst(edge) + 1]++;
+        offsets[EdgeKeySecond(edge) + 1]++;
+    }
+    for (uint32_t vertex = 0; vertex < n; ++vertex) offsets[vertex + 1] += offsets[vertex];
+
+    vector<uint32_t> neighbors(offsets[n]);
+    vector<uint64_t> fill(offsets.begin(), offsets.end() - 1);
+    for (EdgeKey const edge : edges) {
+        neighbors[fill[EdgeKeyFirst(edge)]++] = EdgeKeySecond(edge);
+        neighbors[fill[EdgeKeySecond(edge)]++] = EdgeKeyFirst(edge);
+    }
+    for (uint32_t vertex = 0; vertex < n; ++vertex) {
+        sort(neighbors.begin() + offsets[vertex], neighbors.begin() + offsets[vertex + 1]);
+    }
+
+    if (metis) {
+        fprintf(out, "%u %llu\n", n, static_cast<unsigned long long>(edges.size()));
+        for (uint32_t vertex = 0; vertex < n; ++vertex) {
+            for (uint64_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+                fprintf(out, (i == offsets[vertex]) ? "%u" : " %u", neighbors[i] + 1);
+            }
+            fputc('\n', out);
+        }
+    } else {
+        fprintf(out, "%u\n%llu\n", n, static_cast<unsigned long long>(2 * edges.size()));
+        for (uint32_t vertex = 0; vertex < n; ++vertex) {
+            for (uint64_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+                fprintf(out, "%u,%u\n", vertex, neighbors[i]);
+            }
+        }
+    }
+}
+
+void ShowUsage(char const *program)
+{
+    cerr << "USAGE: " << program << " --model=<er|ba|rmat|planted> [--output=<file>] [--format=<edges|metis>] [--seed=<s>]" << endl;
+    cerr << "   er      : --n=<vertices> --m=<edges>" << endl;
+    cerr << "   ba      : --n=<vertices> --attach=<edges per new vertex>" << endl;
+    cerr << "   rmat    : --scale=<log2 vertices> --m=<edge samples> [--a=0.57 --b=0.19 --c=0.19]" << endl;
+    cerr << "   planted : --n=<vertices> --m=<edges, including planted ones> --clique-size=<k> [--cliques=1]" << endl;
+    cerr << "If --format is missing, a .graph extension on --output selects METIS, and .edges is used otherwise." << endl;
+}
+
+int main(int argc, char** argv)
+{
+    map<string, string> mapCommandLineArgs;
+    Tools::ProcessCommandLineArgs(argc, argv, mapCommandLineArgs);
+
+    auto const hasArgument = [&mapCommandLineArgs](string const &key) { return mapCommandLineArgs.find(key) != mapCommandLineArgs.end(); };
+    auto const getNumber   = [&mapCommandLineArgs](string const &key, double const defaultValue) {
+        return (mapCommandLineArgs.find(key) != mapCommandLineArgs.end()) ? atof(mapCommandLineArgs[key].c_str()) : defaultValue;
+    };
+
+    if (!hasArgument("--model") || hasArgument("--help")) {
+        ShowUsage(argv[0]);
+        return hasArgument("--help") ? 0 : 1;
+    }
+
+    string const model(mapCommandLineArgs["--model"]);
+    string const outputFile(hasArgument("--output") ? mapCommandLineArgs["--output"] : "");
+    bool const metis(hasArgument("--format") ? (mapCommandLineArgs["--format"] == "metis") : Tools::IsMetisFile(outputFile));
+    mt19937_64 generator(static_cast<uint64_t>(getNumber("--seed", 1)));
+
+    uint32_t n(static_cast<uint32_t>(getNumber("--n", 0)));
+    uint64_t const m(static_cast<uint64_t>(getNumber("--m", 0)));
+
+    if (n == 0 && model != "rmat" && model != "kronecker") {
+        cerr << "ERROR: the graph must have at least one vertex (--n)" << endl;
+        return 1;
+    }
+
+    vector<EdgeKey> edges;
+    if (model == "er") {
+        edges = GenerateErdosRenyi(n, m, generator);
+    } else if (model == "ba") {
+        edges = GenerateBarabasiAlbert(n, static_cast<uint32_t>(getNumber("--attach", 3)), generator);
+    } else if (model == "rmat" || model == "kronecker") {
+        uint32_t const scale(static_cast<uint32_t>(getNumber("--scale", 0)));
+        n = (scale > 0 && scale <= 31) ? (1u << scale) : 0;
+        edges = GenerateRMat(scale, m, getNumber("--a", 0.57), getNumber("--b", 0.19), getNumber("--c", 0.19), generator);
+    } else if (model == "planted") {
+        edges = GeneratePlantedCliques(n, m, static_cast<uint32_t>(getNumber("--clique-size", 0)), static_cast<uint32_t>(getNumber("--cliques", 1)), generator);
+    } else {
+        cerr << "ERROR: unrecognized model: " << model << endl;
+        ShowUsage(argv[0]);
+        return 1;
+    }
+
+    FILE *out(outputFile.empty() ? stdout : fopen(outputFile.c_str(), "w"));
+    if (out == nullptr) {
+        fprintf(stderr, "ERROR: unable to write %s\n", outputFile.c_str());
+        return 1;
+    }
+
+    static char buffer[1 << 20];
+    setvbuf(out, buffer, _IOFBF, sizeof(buffer));
+
+    WriteGraph(out, n, edges, metis);
+
+    if (out != stdout) fclose(out);
+    else fflush(out);
+
+    fprintf(stderr, "Generated %s graph: %u vertices, %llu edges\n", model.c_str(), n, static_cast<unsigned long long>(edges.size()));
+    return 0;
+}
@@ -16,17 +16,34 @@
 // local includes
 #include "Tools.h"
 #include "DegeneracyAlgorithm.h"
+#include "TomitaAlgorithm.h"
+#include "AdjacencyListAlgorithm.h"
+#include "HybridAlgorithm.h"
+#include "BitSetTomitaAlgorithm.h"
+#include "ComplementAlgorithm.h"
+#include "GraphStatistics.h"
 #include "CliqueTools.h"
+#include "RunReport.h"
+#include "TopKSelection.h"
+#include "Checkpoint.h"
+#include "Sharding.h"
+#include "RootCostModel.h"
+#include "CliqueWriter.h"
+#include "CliqueStore.h"
+#include "LargestCliques.h"
+#include "DiverseCliques.h"
 
 // system includes
 #include <map>
+#include <algorithm>
 #include <list>
 #include <string>
 #include <vector>
 #include <cassert>
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <cstdlib>
-#include <ctime>
 
 using namespace std;
 
@@ -50,12 +67,33 @@ using namespace std;
 bool   bQuiet;
 bool   bOutputLatex;
 bool   bOutputTable;
+bool   bOutputJson;
+bool   bPrintStatistics;
+bool   bComplement;
 string inputFile;
 string algorithm;
 bool   staging;
 
 bool   bTableMode;
 int K;
+long maxCliques;
+string checkpointFile;
+double checkpointInterval;
+bool   bResume;
+string rootRange;
+string shard;
+string rootCostsFile;
+string outputFile;
+CliqueWriter::Format outputFormat;
+string cliqueStoreDirectory;
+string spillDirectory;
+long   cliqueMemoryMB;
+string objective;
+double overlap;
+bool   bStreamingObjective; //!< the choice is made while enumerating
+int    kBegin;               //!< with --K-range, the smallest K to report
+unsigned long maxSelectionNodes;
+int    numSelectionThreads;  //!< the threads of the branch and bound selection
 
 const int BLOCK = 30000;
 
@@ -76,66 +114,132 @@ void PrintHeader()
     cout << "NOTE: Quick Cliques v2.0beta." << endl;
 }
 
-string basename(string const &fileName)
-{
-    string sBaseName(fileName);
+int n, m;
+class ETKC_Solver {
+private:
+public:
+    ETKC_Solver();
 
-    size_t const lastSlash(sBaseName.find_last_of("/\\"));
-    if (lastSlash != string::npos) {
-        sBaseName = sBaseName.substr(lastSlash+1);
+    Solution global_best;
+    vector<list<int>> adjacencyList;
+    CliqueStore cliques;
+    Algorithm *pAlgorithm = nullptr;
+    RunReport report;
+
+    // progress of the run, for --checkpoint and --resume
+    Checkpoint checkpoint;
+    bool bResumeSelection = false;
+    bool bReusedStore = false;
+
+    // the cliques are written out as they are found, with --output
+    CliqueWriter writer;
+
+    // whether the selection proved its choice optimal, and with --K-range,
+    // the number of values of K for which it did
+    bool bOptimal = true;
+    int numOptimal = 0;
+
+    // the choice so far, with --objective=largest or --objective=diverse
+    LargestCliques largest = LargestCliques(0);
+    DiverseCliques diverse = DiverseCliques(0, 0, 0.0);
+
+    bool OfferClique(int const *begin, int const *end) {
+        if (objective == "diverse") return diverse.Offer(begin, end);
+        return largest.Offer(begin, end);
     }
-
-    size_t const lastDot(sBaseName.find_last_of("."));
-    if (lastDot != string::npos) {
-        sBaseName = sBaseName.substr(0, lastDot);
+    size_t GetSizeThreshold() const {
+        return (objective == "diverse") ? diverse.GetThreshold() : largest.GetThreshold();
     }
 
-    return sBaseName;
-}
-
-
+    // predicted work of each root, compared with the actual work with --stats
+    vector<double> rootCosts;
+    chrono::steady_clock::time_point lastCheckpoint = chrono::steady_clock::now();
 
-class Solution {
-private:
-    vector<int> vertex_cover;
-    vector<list<int>> choose;
-public:
-    int value;
-    void init(int n, int K) {
-        vertex_cover.resize(n);
-        for (int i = 0; i < n; ++i) {
-            vertex_cover[i] = 0;
-        }
-        value = 0;
-        choose.reserve(K);
-    }
-    bool operator< (const Solution &rhs) const {
-        return value < rhs.value;
+    bool CheckpointDue() const {
+        return !checkpointFile.empty() &&
+               chrono::duration<double>(chrono::steady_clock::now() - lastCheckpoint).count() >= checkpointInterval;
     }
-    void add(int x) {
-        if (++vertex_cover[x] == 1) ++value;
-    }
-    void del(int x) {
-        if (--vertex_cover[x] == 0) --value;
+    void SaveCheckpoint(Checkpoint::Phase const phase, int const nextRoot, size_t const nextSelectionIndex,
+                        vector<size_t> const &incumbent) {
+        if (checkpointFile.empty()) return;
+        // the cliques are not copied; they are only read while saving,
+        // possibly while selection threads read them too
+        checkpoint.m_Phase = phase;
+        checkpoint.m_iNextRoot = nextRoot;
+        checkpoint.m_lNextSelectionIndex = nextSelectionIndex;
+        checkpoint.m_vIncumbent = incumbent;
+        bool const bSaved(checkpoint.Save(checkpointFile, cliques));
+        if (!bSaved) {
+            cerr << "WARNING: unable to write checkpoint " << checkpointFile << endl;
+        }
+        lastCheckpoint = chrono::steady_clock::now();
     }
-    void proc(const list<int> &clique, const char &ch) {
-        if (ch == 'A') choose.push_back(clique);
-        else choose.pop_back();
-        for (const int &x : clique) {
-            if (ch == 'A') add(x);
-            else if (ch == 'D') del(x);
-            else assert(false);
+    // reuse the complete clique store of an earlier run on the same graph,
+    // or create the store for later runs
+    void OpenCliqueStore(long const numVertices, long const numEdges, int const beginRoot, int const endRoot) {
+        if (cliques.OpenOnDisk(cliqueStoreDirectory)) {
+            DiskCliqueStore const &store(cliques.GetDiskStore());
+            long storeVertices(-1), storeEdges(-1), storeBeginRoot(-1), storeEndRoot(-1), complete(0);
+            store.GetAttribute("vertices", storeVertices);
+            store.GetAttribute("edges", storeEdges);
+            store.GetAttribute("begin_root", storeBeginRoot);
+            store.GetAttribute("end_root", storeEndRoot);
+            store.GetAttribute("complete", complete);
+            if (storeVertices != numVertices || storeEdges != numEdges || storeBeginRoot != beginRoot || storeEndRoot != endRoot || complete != 1) {
+                cout << "ERROR: clique store " << cliqueStoreDirectory << " was written for a different graph or range of roots, or is incomplete" << endl;
+                exit(1);
+            }
+            bReusedStore = true;
+            cerr << "Reusing clique store " << cliqueStoreDirectory << ": " << cliques.size() << " cliques" << endl << flush;
+            return;
+        }
+
+        if (bResume) LoadCheckpoint(numVertices, numEdges, beginRoot, endRoot);
+
+        if (!cliques.CreateOnDisk(cliqueStoreDirectory)) {
+            cout << "ERROR: unable to create clique store " << cliqueStoreDirectory << endl;
+            exit(1);
         }
+        DiskCliqueStore &store(cliques.GetDiskStore());
+        store.SetAttribute("vertices", numVertices);
+        store.SetAttribute("edges", numEdges);
+        store.SetAttribute("begin_root", beginRoot);
+        store.SetAttribute("end_root", endRoot);
+        store.SetAttribute("complete", 0);
     }
-};
+    void LoadCheckpoint(long const numVertices, long const numEdges, int const beginRoot, int const endRoot) {
+        if (!ifstream(checkpointFile.c_str()).good()) {
+            cerr << "NOTE: no checkpoint " << checkpointFile << " to resume from, starting from the beginning" << endl;
+            return;
+        }
+        if (!checkpoint.Load(checkpointFile)) {
+            cout << "ERROR: unable to read checkpoint " << checkpointFile << endl;
+            exit(1);
+        }
+        if (checkpoint.m_lNumVertices != numVertices || checkpoint.m_lNumEdges != numEdges || checkpoint.m_iK != K) {
+            cout << "ERROR: checkpoint " << checkpointFile << " was written for a different graph or K" << endl;
+            exit(1);
+        }
+        if (checkpoint.m_iBeginRoot != beginRoot || checkpoint.m_iEndRoot != endRoot) {
+            cout << "ERROR: checkpoint " << checkpointFile << " was written for roots " << checkpoint.m_iBeginRoot << ":" << checkpoint.m_iEndRoot << endl;
+            exit(1);
+        }
 
-int n, m;
-class ETKC_Solver {
-private:
-public:
-    Solution now_solution, global_best;
-    vector<list<int>> adjacencyList;
-    function<void(list<int> const&)> top_k_cliques_dfs;
+        cliques.swap(checkpoint.m_vCliques);
+        checkpoint.m_vCliques.clear();
+        if (checkpoint.m_Phase == Checkpoint::PHASE_ENUMERATION) {
+            dynamic_cast<CliqueGenerator*>(pAlgorithm)->Resume(checkpoint.m_iNextRoot, cliques.size());
+        } else {
+            bResumeSelection = true;
+        }
+        cerr << "Resuming from checkpoint " << checkpointFile << ": ";
+        if (bResumeSelection) {
+            cerr << "selection at clique " << checkpoint.m_lNextSelectionIndex;
+        } else {
+            cerr << "enumeration at root vertex " << checkpoint.m_iNextRoot;
+        }
+        cerr << ", " << cliques.size() << " cliques" << endl << flush;
+    }
     void init() {
         if (!bTableMode) {
             PrintHeader();
@@ -143,73 +247,397 @@ public:
             PrintDebugWarning();
     #endif //DEBUG_MESSAGE
         }
-        bool bOneBasedVertexIds(false);
-        if (inputFile.find(".graph") != string::npos) {
-            if (!bTableMode) cout << "Detected .graph extension, reading METIS file format. " << endl << flush;
-            adjacencyList = readInGraphAdjListEdgesPerLine(n, m, inputFile);
-            bOneBasedVertexIds = true;
-        } else {
-            if (!bTableMode) cout << "Reading .edges file format: one edge per line. " << endl << flush;
-            adjacencyList = readInGraphAdjList(n, m, inputFile);
+        report.SetGraphName(Tools::GetBaseName(inputFile));
+        report.SetAlgorithmName(algorithm);
+
+        report.StartPhase(RunReport::PHASE_PARSE);
+        if (!bTableMode) {
+            if (Tools::IsMetisFile(inputFile)) {
+                cout << "Detected .graph extension, reading METIS file format. " << endl << flush;
+            } else {
+                cout << "Reading .edges file format: one edge per line. " << endl << flush;
+            }
+        }
+        adjacencyList = Tools::ReadGraph(inputFile, n, m);
+        report.StopPhase(RunReport::PHASE_PARSE);
+
+        long numEdges(0);
+        for (list<int> const &neighbors : adjacencyList) {
+            numEdges += neighbors.size();
+        }
+        long const numVertices(adjacencyList.size());
+        report.SetNumVertices(numVertices);
+        report.SetNumEdges(numEdges/2);
+
+        // choose the algorithm from cheap statistics of the graph, and log
+        // the decision along with the statistics behind it. The statistics
+        // compute the degeneracy order, which the degeneracy algorithm reuses.
+        NeighborListArray **pOrderingArray(nullptr);
+        if (algorithm == "auto") {
+            report.StartPhase(RunReport::PHASE_ORDERING);
+            GraphStatistics graphStatistics;
+            graphStatistics.Compute(adjacencyList);
+            string reason;
+            algorithm = graphStatistics.ChooseAlgorithm(reason);
+            if (algorithm == "degeneracy") pOrderingArray = graphStatistics.ReleaseOrderingArray();
+            report.StopPhase(RunReport::PHASE_ORDERING);
+
+            cerr << "Graph statistics:" << endl;
+            graphStatistics.Print(cerr);
+            cerr << "Automatic algorithm selection: " << algorithm << " (" << reason << ")" << endl << flush;
+            report.SetAlgorithmName("auto:" + algorithm);
         }
 
-        bool const bComputeAdjacencyMatrix(adjacencyList.size() < 20000);
-        bool const bShouldComputeAdjacencyMatrix(algorithm == "tomita");
+        // the packed matrix takes an eighth of the space of the char matrix
+        bool const bComputeAdjacencyMatrix(adjacencyList.size() < ((algorithm == "bitset") ? BitSetTomitaAlgorithm::MAX_VERTICES : 20000));
+        bool const bShouldComputeAdjacencyMatrix(algorithm == "tomita" || algorithm == "bitset");
 
         if (bShouldComputeAdjacencyMatrix && !bComputeAdjacencyMatrix) {
             cout << "ERROR!: unable to compute adjacencyMatrix, since the graph is too large: " << adjacencyList.size() << " vertices." << endl << flush;
             exit(1);
         }
-        
-    }
-    void new_algorithm() {
-        
-        Algorithm *pAlgorithm(nullptr);
-        if (algorithm == "degeneracy") {
-            pAlgorithm = new DegeneracyAlgorithm(adjacencyList);
+
+        // the algorithm takes ownership of the graph, and keeps only
+        // the representation it needs (e.g., the degeneracy order).
+        report.StartPhase(RunReport::PHASE_ORDERING);
+        if (algorithm == "degeneracy" && pOrderingArray != nullptr) {
+            vector<list<int>>().swap(adjacencyList);
+            pAlgorithm = new DegeneracyAlgorithm(pOrderingArray, numVertices);
+        } else if (algorithm == "degeneracy") {
+            pAlgorithm = new DegeneracyAlgorithm(std::move(adjacencyList));
+        } else if (algorithm == "tomita") {
+            pAlgorithm = new TomitaAlgorithm(std::move(adjacencyList));
+        } else if (algorithm == "bitset") {
+            pAlgorithm = new BitSetTomitaAlgorithm(std::move(adjacencyList));
+        } else if (algorithm == "adjlist") {
+            pAlgorithm = new AdjacencyListAlgorithm(std::move(adjacencyList));
+        } else if (algorithm == "hybrid") {
+            pAlgorithm = new HybridAlgorithm(std::move(adjacencyList));
+        } else if (algorithm == "complement") {
+            pAlgorithm = new ComplementAlgorithm(std::move(adjacencyList));
         } else {
             cout << "ERROR: unrecognized algorithm name: " << algorithm << endl;
             exit(1);
         }
+        report.StopPhase(RunReport::PHASE_ORDERING);
 
-        // Run algorithm
-        
-        pAlgorithm->AddCallBack(top_k_cliques_dfs);
+        if (maxCliques > 0 && dynamic_cast<CliqueGenerator*>(pAlgorithm) == nullptr) {
+            cout << "ERROR: --max-cliques is not supported by algorithm " << algorithm << endl;
+            exit(1);
+        }
 
+        // only generators can be stopped and restarted between roots
+        CliqueGenerator *pGenerator = dynamic_cast<CliqueGenerator*>(pAlgorithm);
+        if (!checkpointFile.empty() && pGenerator == nullptr) {
+            cout << "ERROR: --checkpoint is not supported by algorithm " << algorithm << endl;
+            exit(1);
+        }
+        if ((!rootRange.empty() || !shard.empty()) && pGenerator == nullptr) {
+            cout << "ERROR: --roots and --shard are not supported by algorithm " << algorithm << endl;
+            exit(1);
+        }
+
+        // restrict the enumeration to a range of roots (vertex ids), given
+        // directly, or as a shard whose roots have about 1/N of the estimated work
+        int beginRoot(0), endRoot((pGenerator != nullptr) ? pGenerator->GetNumRoots() : 0);
+        if (!rootRange.empty()) {
+            if (!Sharding::ParseRootRange(rootRange, beginRoot, endRoot)) {
+                cout << "ERROR: invalid range of root vertex ids (expected --roots=<begin>:<end>): " << rootRange << endl;
+                exit(1);
+            }
+            endRoot = min(endRoot, pGenerator->GetNumRoots());
+            beginRoot = min(beginRoot, endRoot);
+        } else if (!shard.empty()) {
+            int shardIndex(0), numShards(1);
+            if (!Sharding::ParseShard(shard, shardIndex, numShards)) {
+                cout << "ERROR: invalid shard (expected --shard=<i>/<N> with 0 <= i < N): " << shard << endl;
+                exit(1);
+            }
+            report.StartPhase(RunReport::PHASE_ORDERING);
+            rootCosts = pGenerator->EstimateRootCosts();
+            report.StopPhase(RunReport::PHASE_ORDERING);
+            Sharding::GetBalancedRange(rootCosts, shardIndex, numShards, beginRoot, endRoot);
+        }
+        if (!rootRange.empty() || !shard.empty()) {
+            pGenerator->SetRootRange(beginRoot, endRoot);
+            cerr << "Enumerating root vertices " << beginRoot << ":" << endRoot << " of " << pGenerator->GetNumRoots() << endl << flush;
+            report.SetCount("begin_root", beginRoot);
+            report.SetCount("end_root", endRoot);
+        }
+
+        checkpoint.m_lNumVertices = numVertices;
+        checkpoint.m_lNumEdges    = numEdges/2;
+        checkpoint.m_iK           = K;
+        checkpoint.m_iBeginRoot   = beginRoot;
+        checkpoint.m_iEndRoot     = endRoot;
+        if (!cliqueStoreDirectory.empty()) {
+            OpenCliqueStore(checkpoint.m_lNumVertices, checkpoint.m_lNumEdges, beginRoot, endRoot);
+        } else if (bResume) {
+            LoadCheckpoint(checkpoint.m_lNumVertices, checkpoint.m_lNumEdges, beginRoot, endRoot);
+        }
+
+        // cliques that outgrow the memory limit move to a temporary store on disk
+        if (cliqueMemoryMB > 0) cliques.SetSpill(spillDirectory, static_cast<size_t>(cliqueMemoryMB) << 20);
+
+        // predict the work of each root, to check the predictions against
+        // the time spent on each root
+        bool const bCompareRootCosts(pGenerator != nullptr && (bPrintStatistics || !rootCostsFile.empty()));
+        if (bCompareRootCosts && rootCosts.empty()) {
+            report.StartPhase(RunReport::PHASE_ORDERING);
+            rootCosts = pGenerator->EstimateRootCosts();
+            report.StopPhase(RunReport::PHASE_ORDERING);
+        }
+
+        // the output starts over on resume, with the cliques of the checkpoint
+        if (!outputFile.empty()) {
+            if (!writer.Open(outputFile, outputFormat)) {
+                cout << "ERROR: unable to open output file " << outputFile << endl;
+                exit(1);
+            }
+            vector<int> clique;
+            for (size_t i = 0; i < cliques.size(); ++i) {
+                cliques.GetClique(i, clique);
+                writer.Write(clique.begin(), clique.end());
+            }
+        }
+
+        if (objective == "largest") largest = LargestCliques(K);
+        if (objective == "diverse") diverse = DiverseCliques(numVertices, K, overlap);
+
+        // algorithms that are not generators report cliques through
+        // callbacks, and cannot skip the cliques that are too small
+        pAlgorithm->AddCallBack([this](list<int> const &clique) {
+            if (bStreamingObjective) {
+                vector<int> const vertices(clique.begin(), clique.end());
+                OfferClique(vertices.data(), vertices.data() + vertices.size());
+                return;
+            }
+            cliques.Add(clique.begin(), clique.end());
+            if (writer.IsOpen()) writer.Write(clique.begin(), clique.end());
+        });
         pAlgorithm->SetQuiet(bQuiet);
-        
-        list<list<int>> cliques;
-        long num = pAlgorithm->Run(cliques);
-        // cerr << "cliques number: " << num << endl;
+        pAlgorithm->SetCollectStatistics(bPrintStatistics || bCompareRootCosts);
+    }
+    void new_algorithm() {
+        // the enumeration was completed before the checkpoint, or by the
+        // run that wrote the clique store
+        if (bResumeSelection || bReusedStore) {
+            if (writer.IsOpen() && !writer.Close()) {
+                cout << "ERROR: unable to write cliques to " << outputFile << endl;
+                exit(1);
+            }
+            report.SetCliqueCount(cliques.size());
+            return;
+        }
+
+        // Run algorithm, once; the top-k search below reads the stored cliques.
+        report.StartPhase(RunReport::PHASE_ENUMERATION);
+        long num(0);
+        bool bStopped(false);
+        CliqueGenerator *pGenerator = dynamic_cast<CliqueGenerator*>(pAlgorithm);
+        if (pGenerator != nullptr) {
+            // pull cliques one at a time, so the enumeration can stop early
+            CliqueSpan clique;
+            int lastRoot(pGenerator->GetCurrentRoot());
+            while (pGenerator->Next(clique)) {
+                // the stored cliques are those of all roots before a new one
+                int const root(pGenerator->GetCurrentRoot());
+                if (root != lastRoot) {
+                    lastRoot = root;
+                    if (CheckpointDue()) SaveCheckpoint(Checkpoint::PHASE_ENUMERATION, root, 0, global_best.chosen());
+                }
+                if (bStreamingObjective) {
+                    // the smallest chosen clique bounds the search
+                    if (OfferClique(clique.begin(), clique.end())) pGenerator->SetSizeThreshold(GetSizeThreshold());
+                } else {
+                    cliques.Add(clique.begin(), clique.end());
+                    if (writer.IsOpen()) writer.Write(clique.begin(), clique.end());
+                }
+                if (maxCliques > 0 && pGenerator->GetCliqueCount() >= maxCliques) {
+                    pGenerator->Stop();
+                    bStopped = true;
+                }
+            }
+            num = pGenerator->GetCliqueCount();
+        } else {
+            list<list<int>> unused;
+            num = pAlgorithm->Run(unused);
+        }
+
+        // only the chosen cliques are kept, and written
+        if (bStreamingObjective) {
+            vector<vector<int>> const chosen((objective == "diverse") ? diverse.GetCliques() : largest.GetCliques());
+            for (vector<int> const &clique : chosen) {
+                cliques.Add(clique.begin(), clique.end());
+                if (writer.IsOpen()) writer.Write(clique.begin(), clique.end());
+            }
+        }
+        if (writer.IsOpen() && !writer.Close()) {
+            cout << "ERROR: unable to write cliques to " << outputFile << endl;
+            exit(1);
+        }
+
+        // a store of all cliques can replace the enumeration of later runs
+        if (cliques.IsOnDisk()) cliques.GetDiskStore().SetAttribute("complete", bStopped ? 0 : 1);
+        if (!cliques.Finish()) {
+            cout << "ERROR: unable to write the clique store" << endl;
+            exit(1);
+        }
+        report.StopPhase(RunReport::PHASE_ENUMERATION);
+        report.SetCliqueCount(num);
+        report.SetSizePruned(bStreamingObjective && pGenerator != nullptr);
+        if (bPrintStatistics) {
+            cerr << "Enumeration statistics:" << endl;
+            pAlgorithm->GetStatistics().Print(cerr);
+            if (cliques.IsOnDisk()) {
+                cerr << "Clique store          : " << cliques.size() << " cliques on disk, " << cliques.GetDiskStore().GetDiskBytes()/1024
+                     << " KB on disk, " << cliques.GetMemoryBytes()/1024 << " KB in memory" << endl;
+            } else {
+                cerr << "Clique store          : " << cliques.size() << " cliques in " << cliques.GetNumNodes()
+                     << " nodes, " << cliques.GetMemoryBytes()/1024 << " KB" << endl;
+            }
+        }
+        if (!rootCosts.empty() && bPrintStatistics) {
+            cerr << "Root cost predictions:" << endl;
+            RootCostModel::PrintComparison(cerr, rootCosts, pAlgorithm->GetStatistics().GetRootSeconds(), pAlgorithm->GetStatistics().GetRootNodes());
+        }
+        if (!rootCosts.empty() && !rootCostsFile.empty()) {
+            ofstream out(rootCostsFile.c_str());
+            if (!out.good()) {
+                cerr << "WARNING: unable to write " << rootCostsFile << endl;
+            } else {
+                RootCostModel::WriteComparison(out, rootCosts, pAlgorithm->GetStatistics().GetRootSeconds(), pAlgorithm->GetStatistics().GetRootNodes());
+            }
+        }
     ////    cout << "Last clique has size: " << cliques.back().size() << endl << flush;
     }
+    // the memory limit of the cliques also bounds their bitsets in the
+    // selection, above which it evaluates choices with counters instead
+    size_t max_bitset_bytes() const {
+        return (cliqueMemoryMB > 0) ? (static_cast<size_t>(cliqueMemoryMB) << 20) : 0;
+    }
+    // best becomes the greedy choice of k cliques, improved by swaps, if
+    // that is better, so the search prunes from the start
+    void seed_greedy(int const k, Solution &best) {
+        Solution seed;
+        seed.init(n, k);
+        for (size_t const index : TopKSelection::SelectGreedy(cliques, n, k)) {
+            seed.proc(cliques, index, 'A');
+        }
+        TopKSelection::ImproveBySwaps(cliques, seed);
+        if (best < seed) best.assign(cliques, seed);
+    }
+    // the best choice for each K up to kEnd, each search starting from the
+    // greedy choice, or from the best choice for K - 1 plus one clique,
+    // improved by swaps
+    void select_range(int const kEnd) {
+        vector<size_t> const greedy(TopKSelection::SelectGreedy(cliques, n, kEnd));
+        Solution greedySolution;
+        greedySolution.init(n, kEnd);
+        Solution previous;
+        previous.init(n, kEnd);
+        Solution incumbent;
+        incumbent.init(n, kEnd);
+        Solution extended;
+        extended.init(n, kEnd);
+
+        ostream &out(bTableMode ? cerr : cout);
+        out << "K\tcoverage\tgreedy\toptimal" << endl;
+        for (int k = 1; k <= kEnd; ++k) {
+            int const previousGreedyValue(greedySolution.value);
+            if (k <= static_cast<int>(greedy.size())) greedySolution.proc(cliques, greedy[k - 1], 'A');
+
+            incumbent.assign(cliques, greedySolution);
+            if (previous.value > previousGreedyValue) {
+                extended.assign(cliques, previous);
+                TopKSelection::AddBestClique(cliques, extended);
+                if (incumbent < extended) incumbent.assign(cliques, extended);
+            }
+            TopKSelection::ImproveBySwaps(cliques, incumbent);
+
+            bool const bProven(TopKSelection::SelectBranchAndBound(cliques, n, k, incumbent, 0, TopKSelection::ProgressCallBack(), maxSelectionNodes, numSelectionThreads, max_bitset_bytes()));
+            if (bProven) numOptimal++;
+            if (k >= kBegin) {
+                out << k << "\t" << incumbent.value << "\t" << greedySolution.value << "\t" << (bProven ? 1 : 0) << endl;
+            }
+            previous.assign(cliques, incumbent);
+        }
+        global_best = previous;
+    }
     void fake_dfs() {
-        int x = 0;
-        global_best.init(n, K);
-        now_solution.init(n, K);
-        top_k_cliques_dfs = [&](list<int> const &clique) {
-            ++x;
-            now_solution.proc(clique, 'A');
-            if (x == K) {
-                if (global_best < now_solution) {
-                    global_best = now_solution;
+        report.StartPhase(RunReport::PHASE_SELECTION);
+        if (kBegin > 0) {
+            select_range(K);
+        } else if (bStreamingObjective) {
+            // the cliques chosen while enumerating are the choice; its value is their coverage
+            global_best.init(n, K);
+            for (size_t i = 0; i < cliques.size(); ++i) {
+                global_best.proc(cliques, i, 'A');
+            }
+        } else if (checkpointFile.empty()) {
+            global_best.init(n, K);
+            seed_greedy(K, global_best);
+            bOptimal = TopKSelection::SelectBranchAndBound(cliques, n, K, global_best, 0, TopKSelection::ProgressCallBack(), maxSelectionNodes, numSelectionThreads, max_bitset_bytes());
+        } else {
+            size_t firstIndex(0);
+            global_best.init(n, K);
+            if (bResumeSelection) {
+                firstIndex = checkpoint.m_lNextSelectionIndex;
+                for (size_t const index : checkpoint.m_vIncumbent) {
+                    global_best.proc(cliques, index, 'A');
                 }
             } else {
-                new_algorithm();
+                seed_greedy(K, global_best);
+                SaveCheckpoint(Checkpoint::PHASE_SELECTION, 0, 0, global_best.chosen());
             }
-            now_solution.proc(clique, 'D');
-            --x;
-        };
-        new_algorithm();
+
+            bOptimal = TopKSelection::SelectBranchAndBound(cliques, n, K, global_best, firstIndex,
+                [this](size_t const nextFirst, vector<size_t> const &best) {
+                    if (CheckpointDue()) SaveCheckpoint(Checkpoint::PHASE_SELECTION, 0, nextFirst, best);
+                }, maxSelectionNodes, numSelectionThreads, max_bitset_bytes());
+            // an unfinished search resumes from the last checkpoint
+            if (bOptimal) SaveCheckpoint(Checkpoint::PHASE_SELECTION, 0, cliques.size(), global_best.chosen());
+        }
+        if (!bOptimal) {
+            cerr << "NOTE: the selection stopped after " << maxSelectionNodes << " nodes, so the best solution may not be optimal" << endl;
+        }
+        report.StopPhase(RunReport::PHASE_SELECTION);
+    }
+    void print_report() {
+        report.SetCount("K", K);
+        report.SetCount("best_solution", global_best.value);
+        if (objective == "diverse") report.SetCount("swaps", diverse.GetNumSwaps());
+        if (kBegin > 0) report.SetCount("optimal_K", numOptimal);
+        if (bStreamingObjective) report.SetCount("smallest_clique", cliques.empty() ? 0 : cliques.GetCliqueSize(cliques.size() - 1));
+        if (bOutputJson) {
+            report.PrintJson(cout);
+        } else if (bOutputLatex) {
+            report.PrintLatex(cout);
+        } else if (bOutputTable) {
+            report.PrintTable(cout, true);
+        } else {
+            report.PrintText(cerr);
+        }
     }
     int solve() {
-        clock_t start = clock();
         init();
-        cout << "### linxi testing!!!" << endl;
+        new_algorithm();
+        delete pAlgorithm;
+        pAlgorithm = nullptr;
         fake_dfs();
-        clock_t end = clock();
-        fprintf(stderr, "cost %f seconds\n", (double)(end-start)/(double)(CLOCKS_PER_SEC));
-        cout << "best solution: " << global_best.value << endl;
+
+        report.StartPhase(RunReport::PHASE_OUTPUT);
+        if (!bTableMode) cout << "best solution: " << global_best.value << endl;
+        if (!bTableMode && bStreamingObjective) {
+            cout << objective << " cliques:";
+            for (size_t i = 0; i < cliques.size(); ++i) {
+                cout << " " << cliques.GetCliqueSize(i);
+            }
+            cout << endl;
+        }
+        report.StopPhase(RunReport::PHASE_OUTPUT);
+
+        print_report();
         ////CommandLineOptions options = ParseCommandLineOptions(argc, argv);
 
         ////if (options.verify) {
@@ -218,29 +646,13 @@ public:
     }
 } solver;
 
-bool isValidAlgorithm(string const &name)
+ETKC_Solver::ETKC_Solver()
 {
-    return (name == "tomita" || name == "adjlist" || name == "hybrid" || name == "degeneracy");
 }
 
-void ProcessCommandLineArgs(int const argc, char** argv, map<string, string> &mapCommandLineArgs)
+bool isValidAlgorithm(string const &name)
 {
-    for (int i = 1; i < argc; ++i) {
-////        cout << "Processing argument " << i << endl;
-        string const argument(argv[i]);
-////        cout << "    Argument is " << argument << endl;
-        size_t const positionOfEquals(argument.find_first_of("="));
-////        cout << "    Position of = " << positionOfEquals << endl;
-        if (positionOfEquals != string::npos) {
-            string const key  (argument.substr(0,positionOfEquals));
-            string const value(argument.substr(positionOfEquals+1));
-////            cout << "    Parsed1: " << key << "=" << value << endl;
-            mapCommandLineArgs[key] = value;
-        } else {
-////            cout << "    Parsed2: " << argument << endl;
-            mapCommandLineArgs[argument] = "";
-        }
-    }
+    return (name == "tomita" || name == "adjlist" || name == "hybrid" || name == "degeneracy" || name == "bitset" || name == "auto" || name == "complement");
 }
 
 int main(int argc, char** argv)
@@ -249,17 +661,101 @@ int main(int argc, char** argv)
 
     map<string, string> mapCommandLineArgs;
 
-    ProcessCommandLineArgs(argc, argv, mapCommandLineArgs);
+    Tools::ProcessCommandLineArgs(argc, argv, mapCommandLineArgs);
 
     bQuiet = (mapCommandLineArgs.find("--verbose") == mapCommandLineArgs.end());
     bOutputLatex = (mapCommandLineArgs.find("--latex") != mapCommandLineArgs.end());
     bOutputTable = (mapCommandLineArgs.find("--table") != mapCommandLineArgs.end());
+    bOutputJson  = (mapCommandLineArgs.find("--json") != mapCommandLineArgs.end());
+    bPrintStatistics = (mapCommandLineArgs.find("--stats") != mapCommandLineArgs.end());
+    bComplement = (mapCommandLineArgs.find("--complement") != mapCommandLineArgs.end());
     inputFile = ((mapCommandLineArgs.find("--input-file") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--input-file"] : "");
     algorithm = ((mapCommandLineArgs.find("--algorithm") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--algorithm"] : "");
     staging = (mapCommandLineArgs.find("--staging") != mapCommandLineArgs.end());
+    maxCliques = ((mapCommandLineArgs.find("--max-cliques") != mapCommandLineArgs.end()) ? stol(mapCommandLineArgs["--max-cliques"]) : 0);
+    checkpointFile = ((mapCommandLineArgs.find("--checkpoint") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--checkpoint"] : "");
+    checkpointInterval = ((mapCommandLineArgs.find("--checkpoint-interval") != mapCommandLineArgs.end()) ? stod(mapCommandLineArgs["--checkpoint-interval"]) : 600.0);
+    bResume = (mapCommandLineArgs.find("--resume") != mapCommandLineArgs.end());
+    rootRange = ((mapCommandLineArgs.find("--roots") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--roots"] : "");
+    shard = ((mapCommandLineArgs.find("--shard") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--shard"] : "");
+    rootCostsFile = ((mapCommandLineArgs.find("--root-costs") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--root-costs"] : "");
+    outputFile = ((mapCommandLineArgs.find("--output") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--output"] : "");
+    outputFormat = CliqueWriter::FORMAT_TEXT;
+    cliqueStoreDirectory = ((mapCommandLineArgs.find("--clique-store") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--clique-store"] : "");
+    cliqueMemoryMB = ((mapCommandLineArgs.find("--clique-memory") != mapCommandLineArgs.end()) ? stol(mapCommandLineArgs["--clique-memory"]) : 0);
+    spillDirectory = ((mapCommandLineArgs.find("--spill-dir") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--spill-dir"] : (getenv("TMPDIR") != nullptr ? getenv("TMPDIR") : "/tmp"));
+    if (mapCommandLineArgs.find("--output-format") != mapCommandLineArgs.end() && !CliqueWriter::ParseFormat(mapCommandLineArgs["--output-format"], outputFormat)) {
+        cout << "ERROR: unrecognized output format (expected text or binary): " << mapCommandLineArgs["--output-format"] << endl;
+        return 1;
+    }
+
+    if (!rootRange.empty() && !shard.empty()) {
+        cout << "ERROR: --roots and --shard cannot be combined" << endl;
+        return 1;
+    }
+
+    objective = ((mapCommandLineArgs.find("--objective") != mapCommandLineArgs.end()) ? mapCommandLineArgs["--objective"] : "coverage");
+    overlap = ((mapCommandLineArgs.find("--overlap") != mapCommandLineArgs.end()) ? stod(mapCommandLineArgs["--overlap"]) : 0.0);
+    if (objective != "coverage" && objective != "largest" && objective != "diverse") {
+        cout << "ERROR: unrecognized objective (expected coverage, largest, or diverse): " << objective << endl;
+        return 1;
+    }
+    if (overlap < 0.0 || overlap > 1.0) {
+        cout << "ERROR: --overlap must be between 0 and 1: " << overlap << endl;
+        return 1;
+    }
+    bStreamingObjective = (objective != "coverage");
+    if (bStreamingObjective && (!checkpointFile.empty() || !cliqueStoreDirectory.empty())) {
+        cout << "ERROR: --checkpoint and --clique-store are not supported with --objective=" << objective << endl;
+        return 1;
+    }
+
+    if (bResume && checkpointFile.empty()) {
+        cout << "ERROR: --resume requires --checkpoint=<filename>" << endl;
+        return 1;
+    }
+
+    // cliques of the complement are found directly on the input graph,
+    // by the only algorithm that works on complemented neighborhoods.
+    if (bComplement) {
+        if (!algorithm.empty() && algorithm != "complement") {
+            cerr << "WARNING: --complement ignores --algorithm=" << algorithm << endl;
+        }
+        algorithm = "complement";
+    }
     
-    assert(mapCommandLineArgs.find("--K") != mapCommandLineArgs.end());
-    K = stoi(mapCommandLineArgs["--K"]);
+    // with --K-range, K is the largest K of the range
+    kBegin = 0;
+    if (mapCommandLineArgs.find("--K-range") != mapCommandLineArgs.end()) {
+        string const &kRange(mapCommandLineArgs["--K-range"]);
+        size_t const colon(kRange.find(':'));
+        int kEnd(0);
+        if (colon != string::npos) {
+            kBegin = atoi(kRange.substr(0, colon).c_str());
+            kEnd   = atoi(kRange.substr(colon + 1).c_str());
+        }
+        if (kBegin < 1 || kEnd < kBegin) {
+            cout << "ERROR: invalid range of K (expected --K-range=<first>:<last> with 1 <= first <= last): " << kRange << endl;
+            return 1;
+        }
+        if (bStreamingObjective || !checkpointFile.empty()) {
+            cout << "ERROR: --K-range is not supported with --checkpoint or --objective=" << objective << endl;
+            return 1;
+        }
+        K = kEnd;
+    } else {
+        assert(mapCommandLineArgs.find("--K") != mapCommandLineArgs.end());
+        K = stoi(mapCommandLineArgs["--K"]);
+    }
+
+    // a sweep of K bounds each search, so one hard K cannot stall the sweep
+    maxSelectionNodes = ((mapCommandLineArgs.find("--max-selection-nodes") != mapCommandLineArgs.end()) ? stoul(mapCommandLineArgs["--max-selection-nodes"]) : ((kBegin > 0) ? 10000000UL : 0UL));
+
+    numSelectionThreads = ((mapCommandLineArgs.find("--threads") != mapCommandLineArgs.end()) ? atoi(mapCommandLineArgs["--threads"].c_str()) : 1);
+    if (numSelectionThreads < 1) {
+        cout << "ERROR: --threads must be at least 1: " << mapCommandLineArgs["--threads"] << endl;
+        return 1;
+    }
 
     if (inputFile.empty()) {
         cout << "ERROR: Missing input file " << endl;
@@ -274,13 +770,13 @@ int main(int argc, char** argv)
     }
 
     if (argc <= 1 || !isValidAlgorithm(algorithm) || inputFile.empty()) {
-        cout << "USAGE: " << argv[0] << " --input-file=<filename> --algorithm=<tomita|adjlist|degeneracy|hybrid>" << endl;
+        cout << "USAGE: " << argv[0] << " --input-file=<filename> --algorithm=<tomita|bitset|adjlist|degeneracy|hybrid|auto|complement> --K=<k>|--K-range=<first>:<last> [--max-selection-nodes=<n>] [--threads=<n>] [--objective=<coverage|largest|diverse> [--overlap=<fraction>]] [--complement] [--max-cliques=<n>] [--checkpoint=<filename> [--checkpoint-interval=<seconds>] [--resume]] [--roots=<begin vertex>:<end vertex>|--shard=<i>/<N>] [--table|--latex|--json] [--stats] [--root-costs=<filename>] [--output=<filename> [--output-format=<text|binary>]] [--clique-store=<directory>] [--clique-memory=<MB> [--spill-dir=<directory>]]" << endl;
         return 1;
     }
 
 
 
-    bTableMode = (bOutputLatex || bOutputTable);
+    bTableMode = (bOutputLatex || bOutputTable || bOutputJson);
 
     int ret = solver.solve();
 
@@ -0,0 +1,173 @@
+/* 
+    This program is free software: you can redistribute it and/or modify 
+    it under the terms of the GNU General Public License as published by 
+    the Free Software Foundation, either version 3 of the License, or 
+    (at your option) any later version. 
+ 
+    This program is distributed in the hope that it will be useful, 
+    but WITHOUT ANY WARRANTY; without even the implied warranty of 
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+    GNU General Public License for more details. 
+ 
+    You should have received a copy of the GNU General Public License 
+    along with this program.  If not, see <http://www.gnu.org/licenses/> 
+*/
+
+// local includes
+#include "Tools.h"
+#include "Checkpoint.h"
+#include "TopKSelection.h"
+
+// system includes
+#include <map>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+/*! \file merge.cpp
+
+    \brief Combine the results of the shards of a run of qc (see --shard and
+           --roots), given as their final checkpoints: the clique counts are
+           summed, the clique lists are concatenated, and the top-k choice is
+           computed over all cliques, starting from the best choice of any
+           shard.
+
+    \author Darren Strash (first name DOT last name AT gmail DOT com)
+
+    \copyright Copyright (c) 2011-2016 Darren Strash. This code is released under the GNU Public License (GPL) 3.0.
+
+    \image html gplv3-127x51.png
+
+    \htmlonly
+    <center>
+    <a href="gpl-3.0-standalone.html">See GPL 3.0 here</a>
+    </center>
+    \endhtmlonly
+*/
+
+void ShowUsage(char const *program)
+{
+    cerr << "USAGE: " << program << " [--output=<checkpoint>] [--allow-partial] [--threads=<n>] <shard checkpoint> [<shard checkpoint> ...]" << endl;
+    cerr << "Each shard must have been run with --checkpoint=<shard checkpoint> to completion, on the same graph and K." << endl;
+    cerr << "With --output, the merged result is written as a checkpoint of the whole run." << endl;
+    cerr << "With --threads, n threads search for the best choice of K cliques." << endl;
+}
+
+int main(int argc, char** argv)
+{
+    map<string, string> mapCommandLineArgs;
+    vector<string> shardFiles;
+    for (int i = 1; i < argc; ++i) {
+        string const argument(argv[i]);
+        if (argument.compare(0, 2, "--") != 0) shardFiles.push_back(argument);
+    }
+    Tools::ProcessCommandLineArgs(argc, argv, mapCommandLineArgs);
+
+    auto const hasArgument = [&mapCommandLineArgs](string const &key) { return mapCommandLineArgs.find(key) != mapCommandLineArgs.end(); };
+
+    if (shardFiles.empty() || hasArgument("--help")) {
+        ShowUsage(argv[0]);
+        return hasArgument("--help") ? 0 : 1;
+    }
+
+    string const outputFile(hasArgument("--output") ? mapCommandLineArgs["--output"] : "");
+    bool const bAllowPartial(hasArgument("--allow-partial"));
+    int const numThreads(hasArgument("--threads") ? atoi(mapCommandLineArgs["--threads"].c_str()) : 1);
+    if (numThreads < 1) {
+        cerr << "ERROR: --threads must be at least 1: " << mapCommandLineArgs["--threads"] << endl;
+        return 1;
+    }
+
+    Checkpoint merged;
+    Solution best;
+    Solution shardBest;
+    vector<pair<int, int>> rootRanges;
+    for (size_t i = 0; i < shardFiles.size(); ++i) {
+        Checkpoint shard;
+        if (!shard.Load(shardFiles[i])) {
+            cerr << "ERROR: unable to read shard " << shardFiles[i] << endl;
+            return 1;
+        }
+        if (!shard.IsComplete()) {
+            cerr << "ERROR: shard " << shardFiles[i] << " did not complete; resume it with --resume first" << endl;
+            return 1;
+        }
+
+        if (i == 0) {
+            merged.m_lNumVertices = shard.m_lNumVertices;
+            merged.m_lNumEdges    = shard.m_lNumEdges;
+            merged.m_iK           = shard.m_iK;
+            best.init(merged.m_lNumVertices, merged.m_iK);
+        } else if (shard.m_lNumVertices != merged.m_lNumVertices || shard.m_lNumEdges != merged.m_lNumEdges || shard.m_iK != merged.m_iK) {
+            cerr << "ERROR: shard " << shardFiles[i] << " was run on a different graph or K than " << shardFiles[0] << endl;
+            return 1;
+        }
+
+        rootRanges.push_back(make_pair(shard.m_iBeginRoot, shard.m_iEndRoot));
+
+        size_t const offset(merged.m_vCliques.size());
+        vector<int> clique;
+        for (size_t j = 0; j < shard.m_vCliques.size(); ++j) {
+            shard.m_vCliques.GetClique(j, clique);
+            merged.m_vCliques.Add(clique.begin(), clique.end());
+        }
+
+        // the best choice of any shard is a valid choice for the whole run
+        shardBest.init(merged.m_lNumVertices, merged.m_iK);
+        for (size_t const index : shard.m_vIncumbent) {
+            shardBest.proc(merged.m_vCliques, offset + index, 'A');
+        }
+        if (best < shardBest) best.assign(merged.m_vCliques, shardBest);
+
+        cerr << "Shard " << shardFiles[i] << ": roots " << shard.m_iBeginRoot << ":" << shard.m_iEndRoot
+             << ", " << shard.m_vCliques.size() << " cliques, best solution " << shardBest.value << endl;
+    }
+
+    // the shards must list disjoint roots, or cliques would be counted twice,
+    // and all roots, or cliques would be missing
+    sort(rootRanges.begin(), rootRanges.end());
+    int nextRoot(0);
+    for (pair<int, int> const &range : rootRanges) {
+        if (range.first < nextRoot) {
+            cerr << "ERROR: shards overlap at root " << range.first << endl;
+            return 1;
+        }
+        if (range.first > nextRoot && !bAllowPartial) {
+            cerr << "ERROR: no shard has roots " << nextRoot << ":" << range.first << " (use --allow-partial to merge anyway)" << endl;
+            return 1;
+        }
+        nextRoot = range.second;
+    }
+    if (nextRoot < merged.m_lNumVertices && !bAllowPartial) {
+        cerr << "ERROR: no shard has roots " << nextRoot << ":" << merged.m_lNumVertices << " (use --allow-partial to merge anyway)" << endl;
+        return 1;
+    }
+
+    // the best shard choice, improved by swaps, prunes the search of the
+    // merged cliques
+    TopKSelection::ImproveBySwaps(merged.m_vCliques, best);
+    TopKSelection::SelectBranchAndBound(merged.m_vCliques, merged.m_lNumVertices, merged.m_iK, best, 0, TopKSelection::ProgressCallBack(), 0, numThreads);
+
+    cout << "cliques: " << merged.m_vCliques.size() << endl;
+    cout << "best solution: " << best.value << endl;
+
+    if (!outputFile.empty()) {
+        merged.m_iBeginRoot = rootRanges.front().first;
+        merged.m_iEndRoot   = nextRoot;
+        merged.m_Phase      = Checkpoint::PHASE_SELECTION;
+        merged.m_iNextRoot  = nextRoot;
+        merged.m_lNextSelectionIndex = merged.m_vCliques.size();
+        merged.m_vIncumbent = best.chosen();
+        if (!merged.Save(outputFile)) {
+            cerr << "ERROR: unable to write " << outputFile << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#! /bin/bash
+
+# generate synthetic graphs that sweep the number of vertices, the number
+# of edges, and the degeneracy, and benchmark them with qcbench.
+#
+# usage: utils/scalingbench.sh [output csv] [extra qcbench arguments]
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )/.." && pwd )"
+cd $DIR
+
+make bin/gengraph bin/qcbench || exit 1
+
+GRAPH_DIR=$(mktemp -d)
+trap "rm -rf $GRAPH_DIR" EXIT
+
+OUTPUT=${1:-scaling.csv}
+shift
+
+# sweep n, with average degree 10
+for n in 10000 100000 1000000
+do
+    bin/gengraph --model=er --n=$n --m=$((5*n)) --output=$GRAPH_DIR/er-n$n.edges
+done
+
+# sweep m, with a fixed number of vertices
+for m in 200000 400000 800000 1600000
+do
+    bin/gengraph --model=rmat --scale=17 --m=$m --output=$GRAPH_DIR/rmat-m$m.edges
+done
+
+# sweep degeneracy
+for d in 4 16 64
+do
+    bin/gengraph --model=ba --n=100000 --attach=$d --output=$GRAPH_DIR/ba-d$d.edges
+done
+for k in 20 50 100
+do
+    bin/gengraph --model=planted --n=100000 --m=500000 --clique-size=$k --cliques=10 --output=$GRAPH_DIR/planted-k$k.edges
+done
+
+bin/qcbench --input-dir=$GRAPH_DIR --K=1,2 --repeat=3 --output=$OUTPUT "$@"
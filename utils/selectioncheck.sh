@@ -0,0 +1,32 @@
+#! /bin/bash
+
+# check that the branch and bound top-k selection finds the same best
+# value as the exhaustive one, with one and several threads, on synthetic
+# graphs and the biogrid graphs, for K = 1, ..., 4.
+#
+# usage: utils/selectioncheck.sh [bin directory] [extra qccheck arguments]
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )/.." && pwd )"
+cd $DIR
+
+BIN_DIR=${1:-bin}
+shift
+
+GRAPH_DIR=$(mktemp -d)
+trap "rm -rf $GRAPH_DIR" EXIT
+
+# sparse and dense random graphs, high degeneracy, skewed degrees, and
+# large cliques that overlap many small ones
+for seed in 1 2 3
+do
+    $BIN_DIR/gengraph --model=er --n=60 --m=300 --seed=$seed --output=$GRAPH_DIR/er-sparse-$seed.edges || exit 1
+    $BIN_DIR/gengraph --model=er --n=40 --m=500 --seed=$seed --output=$GRAPH_DIR/er-dense-$seed.edges || exit 1
+    $BIN_DIR/gengraph --model=ba --n=200 --attach=6 --seed=$seed --output=$GRAPH_DIR/ba-$seed.edges || exit 1
+    $BIN_DIR/gengraph --model=rmat --scale=8 --m=2000 --seed=$seed --output=$GRAPH_DIR/rmat-$seed.edges || exit 1
+    $BIN_DIR/gengraph --model=planted --n=150 --m=900 --clique-size=10 --cliques=3 --seed=$seed --output=$GRAPH_DIR/planted-$seed.edges || exit 1
+done
+
+STATUS=0
+$BIN_DIR/qccheck --input-dir=$GRAPH_DIR --K=1,2,3,4 "$@" || STATUS=1
+$BIN_DIR/qccheck --input-dir=data/biogrid --K=1,2,3,4 "$@" || STATUS=1
+exit $STATUS
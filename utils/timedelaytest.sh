@@ -1 +1,16 @@
+#! /bin/bash
 
+# report the delay between consecutive maximal cliques (recursive calls
+# and nanoseconds), for every graph in the data directory.
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )/.." && pwd )"
+cd $DIR
+
+make
+
+for i in data/*/*
+do
+    echo $i
+    bin/qc --algorithm=degeneracy --input-file=$i --K=1 --stats 2>&1 > /dev/null | sed -n '/^Enumeration statistics:/,/^Steps between cliques:/p'
+    echo " "
+done